@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ge/Icosahedron.hpp"
+#include <memory>
+
+namespace fury::benchmark_utils
+{
+	// unit sphere with 20 * 4^subdivision_depth triangles
+	inline std::unique_ptr<Icosahedron> make_sphere(int subdivision_depth)
+	{
+		auto sphere = std::make_unique<Icosahedron>();
+		sphere->subdivide_triangles(subdivision_depth);
+		sphere->project_points_on_sphere();
+		return sphere;
+	}
+
+	inline size_t face_count(const Object3D& obj)
+	{
+		size_t count = 0;
+		for (const Mesh& mesh : obj.get_meshes())
+		{
+			count += mesh.faces().size();
+		}
+		return count;
+	}
+}
@@ -0,0 +1,53 @@
+#include "core/Event.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace fury;
+
+namespace
+{
+	struct Listener
+	{
+		void on_value(int value) { sum += value; }
+		int64_t sum = 0;
+	};
+
+	int64_t function_sum = 0;
+	void on_value(int value)
+	{
+		function_sum += value;
+	}
+}
+
+static void BM_EventNotifyInstanceListeners(benchmark::State& state)
+{
+	std::vector<Listener> listeners(state.range(0));
+	Event<int> event;
+	for (Listener& listener : listeners)
+	{
+		event += new InstanceListener(&listener, &Listener::on_value);
+	}
+	for (auto _ : state)
+	{
+		event.notify(1);
+	}
+	benchmark::DoNotOptimize(listeners.back().sum);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventNotifyInstanceListeners)->ArgName("listeners")->RangeMultiplier(4)->Range(1, 1024);
+
+static void BM_EventNotifyFunctionListeners(benchmark::State& state)
+{
+	Event<int> event;
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		event += new FunctionListener(on_value);
+	}
+	for (auto _ : state)
+	{
+		event.notify(1);
+	}
+	benchmark::DoNotOptimize(function_sum);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventNotifyFunctionListeners)->ArgName("listeners")->RangeMultiplier(4)->Range(1, 1024);
@@ -0,0 +1,39 @@
+#include "core/Frustum.hpp"
+#include "ge/BoundingBox.hpp"
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+using namespace fury;
+
+static void BM_FrustumIsInside(benchmark::State& state)
+{
+	const glm::mat4 projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 200.f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.f, 0.f, 0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+	const Frustum frustum = Frustum::from_matrix(projection * view);
+	// fixed seed, so runs of different commits test the same boxes. roughly a half of them is visible
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> pos(-100.f, 100.f);
+	std::uniform_real_distribution<float> extent(0.1f, 2.f);
+	std::vector<BoundingBox> boxes;
+	boxes.reserve(state.range(0));
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		const glm::vec3 center(pos(rng), pos(rng), pos(rng) - 100.f);
+		const glm::vec3 half_size(extent(rng));
+		boxes.emplace_back(center - half_size, center + half_size);
+	}
+	for (auto _ : state)
+	{
+		size_t visible = 0;
+		for (const BoundingBox& bbox : boxes)
+		{
+			visible += frustum.is_inside(bbox);
+		}
+		benchmark::DoNotOptimize(visible);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FrustumIsInside)->ArgName("boxes")->RangeMultiplier(8)->Range(64, 1 << 18)->Complexity(benchmark::oN);
@@ -0,0 +1,18 @@
+#include "ge/Icosahedron.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace fury;
+
+static void BM_IcosahedronSubdivideTriangles(benchmark::State& state)
+{
+	const int depth = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		// construction of base 20 faces is negligible next to subdivision
+		Icosahedron ico;
+		ico.subdivide_triangles(depth);
+		benchmark::DoNotOptimize(ico.get_mesh(0).vertices().data());
+	}
+	state.SetItemsProcessed(state.iterations() * 20 * (int64_t(1) << (2 * depth)));
+}
+BENCHMARK(BM_IcosahedronSubdivideTriangles)->ArgName("subdivision")->DenseRange(0, 6);
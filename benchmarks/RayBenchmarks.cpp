@@ -0,0 +1,21 @@
+#include "BenchmarkUtils.hpp"
+#include "ge/Ray.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace fury;
+
+static void BM_RayIntersectObject3D(benchmark::State& state)
+{
+	auto sphere = benchmark_utils::make_sphere(static_cast<int>(state.range(0)));
+	sphere->calculate_bbox();
+	// hits the sphere, so every triangle is tested
+	const Ray ray(glm::vec3(0.1f, 0.2f, 5.f), glm::vec3(0.f, 0.f, -1.f));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ray.intersect_object3d(sphere.get()));
+	}
+	const size_t faces = benchmark_utils::face_count(*sphere);
+	state.SetItemsProcessed(state.iterations() * faces);
+	state.SetComplexityN(faces);
+}
+BENCHMARK(BM_RayIntersectObject3D)->ArgName("subdivision")->DenseRange(0, 5)->Complexity(benchmark::oN);
@@ -0,0 +1,74 @@
+#include "core/SceneGraph.hpp"
+#include "core/SceneGraphManager.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace fury;
+
+namespace
+{
+	// chain where each node is child of previous one
+	std::vector<std::unique_ptr<TransformationSceneNode>> make_chain(size_t depth)
+	{
+		std::vector<std::unique_ptr<TransformationSceneNode>> nodes;
+		nodes.reserve(depth);
+		for (size_t i = 0; i < depth; i++)
+		{
+			auto& node = nodes.emplace_back(std::make_unique<TransformationSceneNode>());
+			node->set_translation(glm::vec3(1.f, 0.f, 0.f));
+			node->set_rotation(glm::vec3(0.f, 1.f, 0.f), 5.f);
+			if (i > 0)
+			{
+				node->set_parent(nodes[i - 1].get());
+			}
+		}
+		return nodes;
+	}
+}
+
+static void BM_TransformationSceneNodeUpdate(benchmark::State& state)
+{
+	auto nodes = make_chain(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		// marking goes through SceneGraphManager dirty set, only propagation of transforms is measured
+		state.PauseTiming();
+		nodes.front()->mark_dirty();
+		state.ResumeTiming();
+		nodes.front()->update();
+		benchmark::DoNotOptimize(nodes.back()->get_world_mat());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetComplexityN(state.range(0));
+	SceneGraphManager::clear();
+	// children first, so nobody releases already destroyed node
+	while (!nodes.empty())
+	{
+		nodes.pop_back();
+	}
+}
+BENCHMARK(BM_TransformationSceneNodeUpdate)->ArgName("depth")->RangeMultiplier(4)->Range(4, 4096)->Complexity(benchmark::oN);
+
+// setting transform of root marks whole hierarchy dirty, then the frame updates it
+static void BM_TransformationSceneNodeMarkDirtyAndUpdate(benchmark::State& state)
+{
+	auto nodes = make_chain(static_cast<size_t>(state.range(0)));
+	float angle = 0.f;
+	for (auto _ : state)
+	{
+		angle += 1.f;
+		nodes.front()->set_rotation(glm::vec3(0.f, 1.f, 0.f), angle);
+		nodes.front()->update();
+		SceneGraphManager::clear_dirty_nodes();
+		benchmark::DoNotOptimize(nodes.back()->get_world_mat());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetComplexityN(state.range(0));
+	SceneGraphManager::clear();
+	while (!nodes.empty())
+	{
+		nodes.pop_back();
+	}
+}
+BENCHMARK(BM_TransformationSceneNodeMarkDirtyAndUpdate)->ArgName("depth")->RangeMultiplier(4)->Range(4, 4096)->Complexity(benchmark::oN);
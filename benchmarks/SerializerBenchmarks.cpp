@@ -0,0 +1,58 @@
+#include "BenchmarkUtils.hpp"
+#include "core/Serialization.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace fury;
+
+namespace
+{
+	const std::filesystem::path benchmark_file = std::filesystem::temp_directory_path() / "fury_serializer_benchmark.bin";
+
+	// plain Object3D with sphere meshes, so only Object3D fields and its bases are serialized
+	std::unique_ptr<Object3D> make_object(int subdivision_depth)
+	{
+		auto obj = std::make_unique<Object3D>();
+		obj->set_meshes_data(std::make_shared<std::vector<Mesh>>(benchmark_utils::make_sphere(subdivision_depth)->get_meshes()));
+		obj->calculate_bbox();
+		return obj;
+	}
+}
+
+static void BM_SerializerObject3DWrite(benchmark::State& state)
+{
+	const auto obj = make_object(static_cast<int>(state.range(0)));
+	std::ofstream ofs(benchmark_file, std::ios_base::binary);
+	uint64_t bytes = 0;
+	for (auto _ : state)
+	{
+		ofs.seekp(0);
+		serializer::prepare_for_serialization();
+		bytes = Serializer<Object3D>::write(ofs, obj.get());
+	}
+	state.SetBytesProcessed(state.iterations() * bytes);
+	state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_SerializerObject3DWrite)->ArgName("subdivision")->DenseRange(0, 5);
+
+static void BM_SerializerObject3DRead(benchmark::State& state)
+{
+	{
+		const auto obj = make_object(static_cast<int>(state.range(0)));
+		std::ofstream ofs(benchmark_file, std::ios_base::binary);
+		serializer::prepare_for_serialization();
+		Serializer<Object3D>::write(ofs, obj.get());
+	}
+	std::ifstream ifs(benchmark_file, std::ios_base::binary);
+	Object3D obj;
+	uint64_t bytes = 0;
+	for (auto _ : state)
+	{
+		ifs.seekg(0);
+		serializer::prepare_for_serialization();
+		bytes = Serializer<Object3D>::read(ifs, &obj);
+	}
+	state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_SerializerObject3DRead)->ArgName("subdivision")->DenseRange(0, 5);
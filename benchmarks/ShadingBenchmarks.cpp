@@ -0,0 +1,27 @@
+#include "BenchmarkUtils.hpp"
+#include "ge/ShadingProcessor.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace fury;
+
+static void BM_ShadingProcessorApplyShading(benchmark::State& state)
+{
+	const auto sphere = benchmark_utils::make_sphere(static_cast<int>(state.range(0)));
+	const auto mode = static_cast<ShadingProcessor::ShadingMode>(state.range(1));
+	for (auto _ : state)
+	{
+		// shading rewrites meshes, so each run starts from the original ones
+		state.PauseTiming();
+		std::vector<Mesh> meshes = sphere->get_meshes();
+		state.ResumeTiming();
+		ShadingProcessor::apply_shading(meshes, mode);
+		benchmark::DoNotOptimize(meshes.data());
+	}
+	state.SetItemsProcessed(state.iterations() * benchmark_utils::face_count(*sphere));
+}
+BENCHMARK(BM_ShadingProcessorApplyShading)
+	->ArgNames({ "subdivision", "mode" })
+	->ArgsProduct({
+		benchmark::CreateDenseRange(0, 5, 1),
+		{ ShadingProcessor::FLAT_SHADING, ShadingProcessor::SMOOTH_SHADING }
+	});
@@ -0,0 +1,16 @@
+#include "core/Logger.hpp"
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+	// engine logs on every icosahedron subdivision and warns about destroyed entities without scene nodes
+	spdlog::set_level(spdlog::level::err);
+	::benchmark::Initialize(&argc, argv);
+	if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+	{
+		return 1;
+	}
+	::benchmark::RunSpecifiedBenchmarks();
+	::benchmark::Shutdown();
+	return 0;
+}
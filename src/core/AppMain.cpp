@@ -1,11 +1,13 @@
 #include "Application.hpp"
 #include "Logger.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
   try
   {
+    const fury::LaunchOptions options = fury::LaunchOptions::parse(argc, argv);
     auto& app = fury::Application::instance();
+    app.init(options);
     app.run();
   }
   catch (const std::exception& e)
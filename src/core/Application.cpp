@@ -3,8 +3,10 @@
 #include "Logger.hpp"
 #include "AssetManager.hpp"
 #include "ShaderStorage.hpp"
+#include "FrameBenchmark.hpp"
 #include <GLFW/glfw3.h>
 #include <stdexcept>
+#include <fstream>
 
 static void setup_opengl()
 {
@@ -23,17 +25,36 @@ namespace fury
 {
   Application::Application()
   {
+  }
+
+  void Application::init(const LaunchOptions& options)
+  {
+    m_options = options;
+    if (options.is_headless())
+    {
+      // null platform needs no display, context is created by OSMesa or EGL
+      glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
     if (glfwInit() != GLFW_TRUE)
     {
       Logger::critical("Failed to init glfw");
       throw std::runtime_error("Failed to init glfw");
     }
-    m_window.init(1600, 900, "MainWindow");
+    m_window.init(1600, 900, "MainWindow", options.headless);
     AssetManager::init();
     ShaderStorage::init();
     InputSystem::instance().init(&m_window);
     Scene::instance().init(&m_window);
+    if (options.stress_scene)
+    {
+      Scene::instance().create_stress_scene(*options.stress_scene);
+    }
     ::setup_opengl();
+    if (options.is_headless() || options.frame_count > 0)
+    {
+      // throughput runs aren't paced to monitor refresh rate
+      Scene::instance().set_fps_limit(0);
+    }
   }
 
   Application::~Application()
@@ -43,6 +64,25 @@ namespace fury
 
   void Application::run()
   {
-    Scene::instance().render();
+    if (!m_options.benchmark)
+    {
+      Scene::instance().render(m_options.frame_count);
+      return;
+    }
+    FrameBenchmark benchmark(m_options.frame_count);
+    Scene::instance().render(m_options.frame_count, &benchmark);
+    benchmark.log_report();
+    if (m_options.benchmark_report.empty())
+    {
+      return;
+    }
+    std::ofstream ofs(m_options.benchmark_report);
+    if (!ofs)
+    {
+      Logger::error("Failed to open {} for benchmark report", m_options.benchmark_report);
+      return;
+    }
+    benchmark.write_report(ofs);
+    Logger::info("Benchmark report written to {}", m_options.benchmark_report);
   }
 }
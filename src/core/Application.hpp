@@ -2,12 +2,14 @@
 
 #include "WindowGLFW.hpp"
 #include "Singleton.hpp"
+#include "LaunchOptions.hpp"
 
 namespace fury
 {
   class Application : public Singleton<Application>
   {
   public:
+    void init(const LaunchOptions& options);
     void run();
     ~Application();
   private:
@@ -15,5 +17,6 @@ namespace fury
     friend class Singleton<Application>;
   private:
     WindowGLFW m_window;
+    LaunchOptions m_options;
   };
 };
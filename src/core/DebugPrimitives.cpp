@@ -0,0 +1,111 @@
+#include "DebugPrimitives.hpp"
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+
+namespace
+{
+  constexpr int cube_edges[24] = {
+    0, 1, 1, 2, 2, 3, 3, 0, // front
+    4, 5, 5, 6, 6, 7, 7, 4, // back
+    0, 4, 1, 5, 2, 6, 3, 7  // sides
+  };
+
+  void add_cube_edges(std::vector<glm::vec3>& vertices, float half_size)
+  {
+    const float h = half_size;
+    const glm::vec3 corners[8] = {
+      { -h, -h, h }, { h, -h, h }, { h, h, h }, { -h, h, h },
+      { -h, -h, -h }, { h, -h, -h }, { h, h, -h }, { -h, h, -h }
+    };
+    for (int idx : cube_edges)
+    {
+      vertices.push_back(corners[idx]);
+    }
+  }
+}
+
+namespace fury
+{
+  namespace debug_primitives
+  {
+    Meshes make_meshes()
+    {
+      Meshes meshes;
+      auto begin = [&](Type type) { meshes.ranges[static_cast<size_t>(type)].first = static_cast<uint32_t>(meshes.vertices.size()); };
+      auto end = [&](Type type)
+      {
+        MeshRange& range = meshes.ranges[static_cast<size_t>(type)];
+        range.count = static_cast<uint32_t>(meshes.vertices.size()) - range.first;
+      };
+
+      begin(Type::LINE);
+      meshes.vertices.emplace_back(0.f);
+      meshes.vertices.emplace_back(1.f, 0.f, 0.f);
+      end(Type::LINE);
+
+      begin(Type::SPHERE);
+      for (int axis = 0; axis < 3; axis++)
+      {
+        for (uint32_t i = 0; i < sphere_segments; i++)
+        {
+          for (uint32_t point : { i, i + 1 })
+          {
+            const float angle = glm::two_pi<float>() * point / sphere_segments;
+            glm::vec3 v(0.f);
+            v[(axis + 1) % 3] = std::cos(angle);
+            v[(axis + 2) % 3] = std::sin(angle);
+            meshes.vertices.push_back(v);
+          }
+        }
+      }
+      end(Type::SPHERE);
+
+      begin(Type::FRUSTUM);
+      add_cube_edges(meshes.vertices, 1.f);
+      end(Type::FRUSTUM);
+
+      begin(Type::BOX);
+      add_cube_edges(meshes.vertices, 0.5f);
+      end(Type::BOX);
+      return meshes;
+    }
+
+    Instance line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color)
+    {
+      Instance instance;
+      instance.transform = glm::mat4(0.f);
+      instance.transform[0] = glm::vec4(b - a, 0.f);
+      instance.transform[3] = glm::vec4(a, 1.f);
+      instance.color = color;
+      return instance;
+    }
+
+    Instance sphere(const glm::vec3& center, float radius, const glm::vec4& color)
+    {
+      Instance instance;
+      instance.transform = glm::mat4(radius);
+      instance.transform[3] = glm::vec4(center, 1.f);
+      instance.color = color;
+      return instance;
+    }
+
+    Instance frustum(const glm::mat4& view_proj, const glm::vec4& color)
+    {
+      return { glm::inverse(view_proj), color };
+    }
+
+    Instance box(const BoundingBox& bbox, const glm::mat4& transform, const glm::vec4& color)
+    {
+      const BoundingBox world_bbox = bbox.transformed(transform);
+      const glm::vec3 extents_world = world_bbox.max() - world_bbox.min();
+      Instance instance;
+      instance.transform = glm::mat4(1.f);
+      instance.transform[0][0] = extents_world.x;
+      instance.transform[1][1] = extents_world.y;
+      instance.transform[2][2] = extents_world.z;
+      instance.transform[3] = glm::vec4(world_bbox.center(), 1.f);
+      instance.color = color;
+      return instance;
+    }
+  }
+}
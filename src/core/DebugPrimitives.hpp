@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ge/BoundingBox.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace fury
+{
+  // Debug primitives are instances of unit line meshes: every instance is a transform of its primitive mesh
+  // and a color, so each primitive type is drawn with one instanced draw whatever number of instances it has
+  namespace debug_primitives
+  {
+    enum class Type : uint8_t
+    {
+      LINE,
+      SPHERE,
+      FRUSTUM,
+      BOX,
+      COUNT
+    };
+
+    // layout must match debug_primitives.vert
+    struct Instance
+    {
+      // may be projective, shader divides by w
+      glm::mat4 transform = glm::mat4(1.f);
+      glm::vec4 color = glm::vec4(1.f);
+    };
+    static_assert(sizeof(Instance) % 16 == 0);
+
+    // vertices of primitive in mesh of all primitives
+    struct MeshRange
+    {
+      uint32_t first = 0;
+      uint32_t count = 0;
+    };
+
+    struct Meshes
+    {
+      // pairs of vertices make GL_LINES
+      std::vector<glm::vec3> vertices;
+      std::array<MeshRange, static_cast<size_t>(Type::COUNT)> ranges;
+    };
+
+    constexpr uint32_t sphere_segments = 32;
+
+    // line from (0, 0, 0) to (1, 0, 0), unit sphere as 3 great circles, edges of [-1, 1] cube for frustum
+    // in clip space and edges of [-0.5, 0.5] cube for boxes
+    Meshes make_meshes();
+    Instance line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color);
+    Instance sphere(const glm::vec3& center, float radius, const glm::vec4& color);
+    // frustum of view projection matrix
+    Instance frustum(const glm::mat4& view_proj, const glm::vec4& color);
+    // world space AABB of transformed bbox
+    Instance box(const BoundingBox& bbox, const glm::mat4& transform, const glm::vec4& color);
+  }
+}
@@ -1,5 +1,18 @@
 #include "FPSLimiter.hpp"
 #include "Logger.hpp"
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#ifdef __linux__
+  #include <ctime>
+  #include <cerrno>
+#elif _WIN32
+  #include <Windows.h>
+  // windows 10 1803+, older sdk doesn't define it
+  #ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+    #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+  #endif
+#endif
 
 namespace fury
 {
@@ -19,20 +32,123 @@ namespace fury
     {
       m_limit = fps;
     }
-    const float frametime = (m_limit == 0) ? 0.f : 1.f / m_limit;
-    m_start = std::chrono::steady_clock::now().time_since_epoch();
-    m_frametime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float>(frametime));
+    m_frametime = (m_limit == 0) ? clock::duration::zero() :
+      std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(1'000'000'000 / m_limit));
+    m_deadline = clock::now() + m_frametime;
+    m_last_frame.reset();
+    m_frame_times_count = 0;
+    m_frame_times_idx = 0;
   }
 
   void FPSLimiter::wait()
   {
-    if (!has_limit())
+    if (has_limit())
+    {
+      if (clock::now() < m_deadline - spin_threshold)
+      {
+        sleep_until(m_deadline - spin_threshold);
+      }
+      while (clock::now() < m_deadline)
+      {
+        std::this_thread::yield();
+      }
+    }
+    const clock::time_point now = clock::now();
+    if (has_limit())
+    {
+      m_deadline = advance_deadline(m_deadline, m_frametime, now);
+    }
+    record_frame(now);
+  }
+
+  FPSLimiter::clock::time_point FPSLimiter::advance_deadline(clock::time_point deadline, clock::duration frametime, clock::time_point now)
+  {
+    if (now - deadline >= frametime)
+    {
+      return now + frametime;
+    }
+    return deadline + frametime;
+  }
+
+  void FPSLimiter::sleep_until(clock::time_point time)
+  {
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC, absolute time doesn't accumulate error when sleep is interrupted
+    const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+    }
+#elif _WIN32
+    // regular sleep has granularity of system timer (15.6ms by default), which is most of the frame at 60 fps.
+    // handle lives until thread exits
+    thread_local const HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    const clock::duration remaining = time - clock::now();
+    if (remaining <= clock::duration::zero())
+    {
       return;
-    while (std::chrono::steady_clock::now().time_since_epoch() < m_start + m_frametime)
+    }
+    if (timer)
+    {
+      LARGE_INTEGER due_time;
+      // relative time in 100ns intervals
+      due_time.QuadPart = -std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100;
+      if (SetWaitableTimerEx(timer, &due_time, 0, nullptr, nullptr, nullptr, 0))
+      {
+        WaitForSingleObject(timer, INFINITE);
+        return;
+      }
+    }
+    // no high resolution timer, sleep only while it can't overshoot and spin the rest
+    constexpr std::chrono::milliseconds timer_granularity{ 16 };
+    if (remaining > timer_granularity)
+    {
+      std::this_thread::sleep_until(time - timer_granularity);
+    }
+#else
+    std::this_thread::sleep_until(time);
+#endif
+  }
+
+  void FPSLimiter::record_frame(clock::time_point now)
+  {
+    if (m_last_frame)
+    {
+      m_frame_times[m_frame_times_idx] = std::chrono::duration<float>(now - *m_last_frame).count();
+      m_frame_times_idx = (m_frame_times_idx + 1) % stats_window;
+      m_frame_times_count = std::min(m_frame_times_count + 1, stats_window);
+    }
+    m_last_frame = now;
+  }
+
+  float FPSLimiter::get_achieved_frame_time() const
+  {
+    if (m_frame_times_count == 0)
+    {
+      return 0.f;
+    }
+    float sum = 0.f;
+    for (size_t i = 0; i < m_frame_times_count; i++)
+    {
+      sum += m_frame_times[i];
+    }
+    return sum / m_frame_times_count;
+  }
+
+  float FPSLimiter::get_jitter() const
+  {
+    if (!has_limit() || m_frame_times_count == 0)
+    {
+      return 0.f;
+    }
+    const float target = get_target_frame_time();
+    float sum = 0.f;
+    for (size_t i = 0; i < m_frame_times_count; i++)
     {
-      std::this_thread::yield();
+      sum += std::abs(m_frame_times[i] - target);
     }
-    //m_start += m_frametime;
-    m_start = std::chrono::steady_clock::now().time_since_epoch();
+    return sum / m_frame_times_count;
   }
 }
@@ -2,22 +2,52 @@
 
 #include <cstdint>
 #include <chrono>
+#include <array>
+#include <optional>
 
 namespace fury
 {
+  // Paces frames to fixed rate. Sleeps until shortly before the deadline and spins only the rest, so CPU is idle
+  // for most of the wait while wakeup stays precise. Deadlines advance by whole frame times, so rate doesn't drift
   class FPSLimiter
   {
   public:
+    using clock = std::chrono::steady_clock;
+    // covers scheduler wakeup latency. high resolution timer on windows may still wake up about a millisecond late
+#ifdef _WIN32
+    constexpr static std::chrono::microseconds spin_threshold{ 2000 };
+#else
+    constexpr static std::chrono::microseconds spin_threshold{ 500 };
+#endif
+    // pacing stats are averaged over this number of frames
+    constexpr static size_t stats_window = 120;
     FPSLimiter() = default;
     FPSLimiter(uint32_t limit);
     void set_limit(uint32_t fps);
     void wait();
     uint32_t get_limit() const { return m_limit; }
     bool has_limit() const { return m_limit != 0; }
+    // in seconds, 0 without limit
+    float get_target_frame_time() const { return std::chrono::duration<float>(m_frametime).count(); }
+    // mean time between returns from wait()
+    float get_achieved_frame_time() const;
+    // mean absolute deviation of frame time from target, 0 without limit
+    float get_jitter() const;
+    // deadline that follows the one that has just been waited for. deadline missed by whole frame is skipped
+    // instead of being caught up with a burst of short frames
+    static clock::time_point advance_deadline(clock::time_point deadline, clock::duration frametime, clock::time_point now);
+  private:
+    static void sleep_until(clock::time_point time);
+    void record_frame(clock::time_point now);
   private:
     // 0 - unlimited
     uint32_t m_limit = 0;
-    std::chrono::nanoseconds m_start = {};
-    std::chrono::nanoseconds m_frametime = {};
+    clock::time_point m_deadline = {};
+    clock::duration m_frametime = {};
+    std::optional<clock::time_point> m_last_frame;
+    // ring of recent frame times in seconds
+    std::array<float, stats_window> m_frame_times = {};
+    size_t m_frame_times_count = 0;
+    size_t m_frame_times_idx = 0;
   };
 }
@@ -0,0 +1,98 @@
+#include "FrameBenchmark.hpp"
+#include "Logger.hpp"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+  void write_percentiles(std::ostream& os, const fury::FrameBenchmark::Percentiles& p)
+  {
+    os << "{\"p50\":" << p.p50 << ",\"p95\":" << p.p95 << ",\"p99\":" << p.p99 << ",\"max\":" << p.max
+       << ",\"mean\":" << p.mean << '}';
+  }
+}
+
+namespace fury
+{
+  FrameBenchmark::CameraPose FrameBenchmark::get_camera_pose(const BoundingBox& bounds, uint32_t frame) const
+  {
+    const glm::vec3 center = bounds.is_empty() ? glm::vec3(0.f) : bounds.center();
+    const float half_diagonal = bounds.is_empty() ? 0.f : glm::length(bounds.max() - bounds.min()) * 0.5f;
+    // flies through outer part of the scene, so both near and far objects are in view
+    const float radius = std::max(half_diagonal * 0.75f, 5.f);
+    const float t = m_frame_count > 0 ? static_cast<float>(frame) / m_frame_count : 0.f;
+    const float angle = t * 2.f * glm::pi<float>();
+    const float height = std::sin(angle * 2.f) * radius * 0.25f;
+    CameraPose pose;
+    pose.position = center + glm::vec3(std::cos(angle) * radius, height, std::sin(angle) * radius);
+    pose.target = center;
+    return pose;
+  }
+
+  void FrameBenchmark::add_phase_time(std::string_view phase, float ms)
+  {
+    auto it = std::find_if(m_phases.begin(), m_phases.end(), [phase](const Phase& p) { return p.name == phase; });
+    if (it == m_phases.end())
+    {
+      it = m_phases.insert(m_phases.end(), Phase{ std::string(phase), {} });
+    }
+    it->samples.push_back(ms);
+  }
+
+  void FrameBenchmark::add_frame(float frame_ms, size_t upload_bytes)
+  {
+    m_frame_times.push_back(frame_ms);
+    m_upload_bytes.push_back(static_cast<float>(upload_bytes));
+  }
+
+  FrameBenchmark::Percentiles FrameBenchmark::get_percentiles(std::vector<float> samples)
+  {
+    Percentiles res;
+    if (samples.empty())
+    {
+      return res;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto rank = [&samples](float p) {
+      const size_t idx = static_cast<size_t>(std::ceil(p * samples.size()));
+      return samples[std::clamp<size_t>(idx, 1, samples.size()) - 1];
+    };
+    res.p50 = rank(0.5f);
+    res.p95 = rank(0.95f);
+    res.p99 = rank(0.99f);
+    res.max = samples.back();
+    res.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    return res;
+  }
+
+  void FrameBenchmark::write_report(std::ostream& os) const
+  {
+    os << "{\"frames\":" << m_frame_times.size() << ",\"frame_time_ms\":";
+    write_percentiles(os, get_percentiles(m_frame_times));
+    os << ",\"upload_bytes\":";
+    write_percentiles(os, get_percentiles(m_upload_bytes));
+    os << ",\"phases_ms\":{";
+    for (size_t i = 0; i < m_phases.size(); i++)
+    {
+      os << (i > 0 ? "," : "") << '"' << m_phases[i].name << "\":";
+      write_percentiles(os, get_percentiles(m_phases[i].samples));
+    }
+    os << "}}\n";
+  }
+
+  void FrameBenchmark::log_report() const
+  {
+    const Percentiles frame = get_percentiles(m_frame_times);
+    Logger::info("Benchmark of {} frames, frame time ms: p50 {:.3f} p95 {:.3f} p99 {:.3f} max {:.3f}",
+      m_frame_times.size(), frame.p50, frame.p95, frame.p99, frame.max);
+    for (const Phase& phase : m_phases)
+    {
+      const Percentiles p = get_percentiles(phase.samples);
+      Logger::info("  {:<14} ms: mean {:.3f} p50 {:.3f} p95 {:.3f} p99 {:.3f}", phase.name, p.mean, p.p50, p.p95, p.p99);
+    }
+    const Percentiles upload = get_percentiles(m_upload_bytes);
+    Logger::info("  Uploaded bytes per frame: mean {:.0f} p95 {:.0f} max {:.0f}", upload.mean, upload.p95, upload.max);
+  }
+}
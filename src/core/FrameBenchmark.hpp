@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ge/BoundingBox.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+
+namespace fury
+{
+  // Scripted run for performance measurements. Camera orbits scene bounds once over the run while time of frames,
+  // CPU time of frame phases and bytes uploaded to buffers are collected per frame
+  class FrameBenchmark
+  {
+  public:
+    struct CameraPose
+    {
+      glm::vec3 position = glm::vec3(0.f);
+      glm::vec3 target = glm::vec3(0.f);
+    };
+    struct Percentiles
+    {
+      float p50 = 0.f;
+      float p95 = 0.f;
+      float p99 = 0.f;
+      float max = 0.f;
+      float mean = 0.f;
+    };
+    explicit FrameBenchmark(uint32_t frame_count) : m_frame_count(frame_count) {}
+    CameraPose get_camera_pose(const BoundingBox& bounds, uint32_t frame) const;
+    // times are in milliseconds
+    void add_phase_time(std::string_view phase, float ms);
+    void add_frame(float frame_ms, size_t upload_bytes);
+    size_t get_recorded_frames() const { return m_frame_times.size(); }
+    // nearest rank percentiles
+    static Percentiles get_percentiles(std::vector<float> samples);
+    void write_report(std::ostream& os) const;
+    void log_report() const;
+  private:
+    struct Phase
+    {
+      std::string name;
+      std::vector<float> samples;
+    };
+  private:
+    uint32_t m_frame_count = 0;
+    std::vector<float> m_frame_times;
+    std::vector<float> m_upload_bytes;
+    // in order of first appearance
+    std::vector<Phase> m_phases;
+  };
+}
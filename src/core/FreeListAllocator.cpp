@@ -0,0 +1,121 @@
+#include "FreeListAllocator.hpp"
+#include "Logger.hpp"
+#include <cassert>
+#include <algorithm>
+
+namespace fury
+{
+  FreeListAllocator::FreeListAllocator(size_t capacity)
+  {
+    reset(capacity);
+  }
+
+  std::optional<size_t> FreeListAllocator::allocate(size_t size)
+  {
+    if (size == 0)
+    {
+      return 0;
+    }
+    for (auto it = m_free_blocks.begin(); it != m_free_blocks.end(); ++it)
+    {
+      auto [offset, block_size] = *it;
+      if (block_size < size)
+      {
+        continue;
+      }
+      m_free_blocks.erase(it);
+      if (block_size > size)
+      {
+        m_free_blocks.emplace(offset + size, block_size - size);
+      }
+      m_used += size;
+      return offset;
+    }
+    return std::nullopt;
+  }
+
+  void FreeListAllocator::free(size_t offset, size_t size)
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    assert(offset + size <= m_capacity);
+    auto next = m_free_blocks.lower_bound(offset);
+    const bool overlaps_next = next != m_free_blocks.end() && next->first < offset + size;
+    // e.g. double free of block that has been merged already
+    const bool overlaps_prev = next != m_free_blocks.begin() && std::prev(next)->first + std::prev(next)->second > offset;
+    if (overlaps_next || overlaps_prev)
+    {
+      Logger::error("FreeListAllocator::free: block at offset {} with size {} overlaps free block.", offset, size);
+      return;
+    }
+    m_used -= size;
+    // merge with previous block
+    if (next != m_free_blocks.begin())
+    {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset)
+      {
+        offset = prev->first;
+        size += prev->second;
+        m_free_blocks.erase(prev);
+      }
+    }
+    // merge with next block
+    if (next != m_free_blocks.end() && offset + size == next->first)
+    {
+      size += next->second;
+      m_free_blocks.erase(next);
+    }
+    m_free_blocks.emplace(offset, size);
+  }
+
+  void FreeListAllocator::grow(size_t new_capacity)
+  {
+    if (new_capacity <= m_capacity)
+    {
+      return;
+    }
+    const size_t old_capacity = m_capacity;
+    const size_t extra = new_capacity - old_capacity;
+    // make free range as used so that free() merges it with last block
+    m_capacity = new_capacity;
+    m_used += extra;
+    free(old_capacity, extra);
+  }
+
+  void FreeListAllocator::reset(size_t capacity)
+  {
+    m_free_blocks.clear();
+    m_capacity = capacity;
+    m_used = 0;
+    if (capacity > 0)
+    {
+      m_free_blocks.emplace(0, capacity);
+    }
+  }
+
+  size_t FreeListAllocator::largest_free_block() const
+  {
+    size_t res = 0;
+    for (const auto& [offset, size] : m_free_blocks)
+    {
+      res = std::max(res, size);
+    }
+    return res;
+  }
+
+  size_t FreeListAllocator::allocated_end() const
+  {
+    if (!m_free_blocks.empty())
+    {
+      const auto& [offset, size] = *m_free_blocks.rbegin();
+      if (offset + size == m_capacity)
+      {
+        return offset;
+      }
+    }
+    return m_capacity;
+  }
+}
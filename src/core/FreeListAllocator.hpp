@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <cstddef>
+
+namespace fury
+{
+  // Offset allocator over [0, capacity) range of abstract units (vertices, indices, bytes).
+  // Doesn't own any memory, only tracks which ranges are free. Adjacent free blocks are merged.
+  class FreeListAllocator
+  {
+  public:
+    FreeListAllocator() = default;
+    FreeListAllocator(size_t capacity);
+    // first fit. zero sized allocations always succeed and return 0
+    std::optional<size_t> allocate(size_t size);
+    void free(size_t offset, size_t size);
+    void grow(size_t new_capacity);
+    void reset(size_t capacity);
+    size_t capacity() const { return m_capacity; }
+    size_t used() const { return m_used; }
+    size_t largest_free_block() const;
+    // end of the last allocated block
+    size_t allocated_end() const;
+    // there is free space before the last allocated block
+    bool has_holes() const { return m_used < allocated_end(); }
+    size_t free_blocks_count() const { return m_free_blocks.size(); }
+  private:
+    // offset -> size
+    std::map<size_t, size_t> m_free_blocks;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+  };
+}
@@ -23,4 +23,22 @@ namespace fury
     }
     return true;
   }
+
+  Frustum Frustum::from_matrix(const glm::mat4& view_proj)
+  {
+    const glm::mat4 m = glm::transpose(view_proj);
+    auto make_plane = [](const glm::vec4& eq)
+      {
+        const float len = glm::length(glm::vec3(eq));
+        return Plane{ glm::vec3(eq) / len, eq.w / len };
+      };
+    Frustum fr;
+    fr.left = make_plane(m[3] + m[0]);
+    fr.right = make_plane(m[3] - m[0]);
+    fr.bottom = make_plane(m[3] + m[1]);
+    fr.top = make_plane(m[3] - m[1]);
+    fr.near = make_plane(m[3] + m[2]);
+    fr.far = make_plane(m[3] - m[2]);
+    return fr;
+  }
 }
@@ -17,5 +17,7 @@ namespace fury
     Plane bottom;
     std::vector<std::pair<glm::vec3, glm::vec3>> debug_lines;
     bool is_inside(const BoundingBox& aabb) const;
+    // planes of clip volume of view projection matrix, normals point inside
+    static Frustum from_matrix(const glm::mat4& view_proj);
   };
 }
@@ -0,0 +1,86 @@
+#include "GpuTimers.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+
+namespace fury
+{
+  void GpuTimers::Section::add_sample(float ms)
+  {
+    m_samples[m_next] = ms;
+    m_next = (m_next + 1) % history_size;
+    m_count = std::min(m_count + 1, history_size);
+  }
+
+  float GpuTimers::Section::average() const
+  {
+    if (m_count == 0)
+    {
+      return 0.f;
+    }
+    return std::accumulate(m_samples.begin(), m_samples.begin() + m_count, 0.f) / m_count;
+  }
+
+  float GpuTimers::Section::max() const
+  {
+    return m_count == 0 ? 0.f : *std::max_element(m_samples.begin(), m_samples.begin() + m_count);
+  }
+
+  GpuTimers::~GpuTimers()
+  {
+    for (FrameQueries& frame : m_frames)
+    {
+      glDeleteQueries(static_cast<GLsizei>(frame.pool.size()), frame.pool.data());
+    }
+  }
+
+  void GpuTimers::begin_frame()
+  {
+    FrameQueries& frame = m_frames[RingBuffer::get_frame_slot()];
+    for (const Query& query : frame.used)
+    {
+      // fence of the slot has been waited, but driver may still report result as pending, then sample is dropped
+      GLint available = GL_FALSE;
+      glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+      if (available)
+      {
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &ns);
+        m_sections[query.section].add_sample(static_cast<float>(ns) / 1e6f);
+      }
+      frame.pool.push_back(query.id);
+    }
+    frame.used.clear();
+  }
+
+  void GpuTimers::begin(std::string_view name)
+  {
+    assert(!m_active_section && "GL_TIME_ELAPSED queries can't be nested");
+    auto it = std::find_if(m_sections.begin(), m_sections.end(), [name](const Section& section) { return section.name() == name; });
+    if (it == m_sections.end())
+    {
+      it = m_sections.emplace(m_sections.end(), std::string(name));
+    }
+    FrameQueries& frame = m_frames[RingBuffer::get_frame_slot()];
+    Query query;
+    if (frame.pool.empty())
+    {
+      glGenQueries(1, &query.id);
+    }
+    else
+    {
+      query.id = frame.pool.back();
+      frame.pool.pop_back();
+    }
+    query.section = static_cast<size_t>(it - m_sections.begin());
+    frame.used.push_back(query);
+    m_active_section = query.section;
+    glBeginQuery(GL_TIME_ELAPSED, query.id);
+  }
+
+  void GpuTimers::end()
+  {
+    glEndQuery(GL_TIME_ELAPSED);
+    m_active_section.reset();
+  }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Singleton.hpp"
+#include "opengl/RingBuffer.hpp"
+#include <glad/glad.h>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <array>
+#include <optional>
+
+namespace fury
+{
+  // GPU time of named frame sections, measured with GL_TIME_ELAPSED queries. Queries of each frame slot are read when
+  // the slot is reused, its fence is signaled by then, so reading never stalls. Sections can't be nested
+  class GpuTimers : public Singleton<GpuTimers>
+  {
+  public:
+    // rolling stats over last frames
+    class Section
+    {
+    public:
+      constexpr static size_t history_size = 120;
+      explicit Section(std::string name) : m_name(std::move(name)) {}
+      void add_sample(float ms);
+      const std::string& name() const { return m_name; }
+      float last() const { return m_count == 0 ? 0.f : m_samples[(m_next + history_size - 1) % history_size]; }
+      float average() const;
+      float max() const;
+    private:
+      std::string m_name;
+      std::array<float, history_size> m_samples = {};
+      size_t m_count = 0;
+      size_t m_next = 0;
+    };
+    // reads results of the frame slot that is going to be reused, must be called after RingBuffer::begin_frame
+    void begin_frame();
+    void begin(std::string_view name);
+    void end();
+    // in order of first appearance
+    const std::vector<Section>& get_sections() const { return m_sections; }
+  private:
+    GpuTimers() = default;
+    ~GpuTimers();
+    friend class Singleton<GpuTimers>;
+  private:
+    struct Query
+    {
+      GLuint id = 0;
+      size_t section = 0;
+    };
+    struct FrameQueries
+    {
+      // query objects are reused between frames
+      std::vector<GLuint> pool;
+      std::vector<Query> used;
+    };
+    std::vector<Section> m_sections;
+    std::array<FrameQueries, RingBuffer::frames_in_flight> m_frames;
+    std::optional<size_t> m_active_section;
+  };
+
+  class GpuTimerScope
+  {
+  public:
+    explicit GpuTimerScope(std::string_view name) { GpuTimers::instance().begin(name); }
+    ~GpuTimerScope() { GpuTimers::instance().end(); }
+    GpuTimerScope(const GpuTimerScope&) = delete;
+    GpuTimerScope& operator=(const GpuTimerScope&) = delete;
+  };
+}
@@ -0,0 +1,144 @@
+#include "HiZBuffer.hpp"
+#include "ShaderStorage.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  constexpr GLuint local_size = 8;
+
+  GLuint groups_count(int size)
+  {
+    return (static_cast<GLuint>(size) + local_size - 1) / local_size;
+  }
+}
+
+namespace fury
+{
+  HiZBuffer::~HiZBuffer()
+  {
+    destroy();
+  }
+
+  void HiZBuffer::build(const glm::mat4& view_proj)
+  {
+    GLint viewport[4] = {};
+    GLint draw_fbo = 0;
+    GLint read_fbo = 0;
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_fbo);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_fbo);
+    const int w = viewport[2];
+    const int h = viewport[3];
+    if (w <= 0 || h <= 0)
+    {
+      return;
+    }
+    if (w != m_width || h != m_height)
+    {
+      recreate(w, h);
+    }
+
+    // resolves multisampled depth too. formats must match, scene framebuffers use GL_DEPTH24_STENCIL8
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, draw_fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_depth_fbo);
+    glBlitFramebuffer(viewport[0], viewport[1], viewport[0] + w, viewport[1] + h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, read_fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_fbo);
+
+    Shader& shader = ShaderStorage::get(ShaderStorage::ShaderType::HIZ_BUILD);
+    shader.bind();
+    glActiveTexture(GL_TEXTURE0 + texture_slot);
+    glBindTexture(GL_TEXTURE_2D, m_depth_texture);
+    shader.set_bool("copyDepth", true);
+    glBindImageTexture(0, m_id, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glDispatchCompute(::groups_count(w), ::groups_count(h), 1);
+
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    shader.set_bool("copyDepth", false);
+    for (int level = 1; level < m_levels; level++)
+    {
+      glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+      shader.set_int("srcLevel", level - 1);
+      glBindImageTexture(0, m_id, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+      glDispatchCompute(::groups_count(std::max(w >> level, 1)), ::groups_count(std::max(h >> level, 1)), 1);
+    }
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    shader.unbind();
+    m_view_proj = view_proj;
+  }
+
+  void HiZBuffer::recreate(int w, int h)
+  {
+    destroy();
+    m_width = w;
+    m_height = h;
+    m_levels = static_cast<int>(std::floor(std::log2(std::max(w, h)))) + 1;
+
+    glGenTextures(1, &m_depth_texture.id);
+    glBindTexture(GL_TEXTURE_2D, m_depth_texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, w, h);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenTextures(1, id_ref());
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    glTexStorage2D(GL_TEXTURE_2D, m_levels, GL_R32F, w, h);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint prev_fbo = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_fbo);
+    glGenFramebuffers(1, &m_depth_fbo.id);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_depth_fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_depth_texture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+      Logger::error("HiZBuffer: depth framebuffer {}x{} is not complete.", w, h);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, prev_fbo);
+  }
+
+  void HiZBuffer::destroy()
+  {
+    if (m_depth_fbo != 0)
+    {
+      glDeleteFramebuffers(1, &m_depth_fbo.id);
+      m_depth_fbo.id = 0;
+    }
+    if (m_depth_texture != 0)
+    {
+      glDeleteTextures(1, &m_depth_texture.id);
+      m_depth_texture.id = 0;
+    }
+    if (m_id != 0)
+    {
+      glDeleteTextures(1, id_ref());
+      *id_ref() = 0;
+    }
+    m_width = m_height = m_levels = 0;
+  }
+
+  void HiZBuffer::bind() const
+  {
+    glActiveTexture(GL_TEXTURE0 + texture_slot);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    glActiveTexture(GL_TEXTURE0);
+  }
+
+  void HiZBuffer::unbind() const
+  {
+    glActiveTexture(GL_TEXTURE0 + texture_slot);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+  }
+}
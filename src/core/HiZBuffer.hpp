@@ -0,0 +1,41 @@
+#pragma once
+
+#include "opengl/OpenGLObject.hpp"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace fury
+{
+  // Hierarchical depth pyramid for occlusion culling. Each mip level holds the farthest depth of the texels it covers.
+  // Built from depth of already rendered frame, so it's one frame behind when used for culling.
+  class HiZBuffer : public OpenGLObject
+  {
+  public:
+    // texture unit that pyramid is bound to, must match bindings in hiz_build.comp and culling.comp
+    constexpr static int texture_slot = 16;
+    FURY_OnlyMovable(HiZBuffer)
+    HiZBuffer() = default;
+    ~HiZBuffer();
+    // copy depth of currently bound draw framebuffer and build mip chain. view_proj is the matrix depth was rendered with
+    void build(const glm::mat4& view_proj);
+    bool is_valid() const { return m_id != 0; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int levels() const { return m_levels; }
+    const glm::mat4& get_view_proj() const { return m_view_proj; }
+    // binds pyramid to texture_slot
+    void bind() const override;
+    void unbind() const override;
+  private:
+    void recreate(int w, int h);
+    void destroy();
+  private:
+    // single sampled copy of scene depth, multisampled depth can't be read directly
+    OpenGLIdWrapper<GLuint> m_depth_texture;
+    OpenGLIdWrapper<GLuint> m_depth_fbo;
+    glm::mat4 m_view_proj = glm::mat4(1.f);
+    int m_width = 0;
+    int m_height = 0;
+    int m_levels = 0;
+  };
+}
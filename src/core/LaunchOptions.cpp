@@ -0,0 +1,115 @@
+#include "LaunchOptions.hpp"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <charconv>
+
+namespace
+{
+  template<typename T>
+  T parse_number(std::string_view option, std::string_view value)
+  {
+    T number = {};
+    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (value.empty() || ec != std::errc() || ptr != value.data() + value.size())
+    {
+      throw std::invalid_argument(std::string(option) + " expects a number, got '" + std::string(value) + "'");
+    }
+    return number;
+  }
+}
+
+namespace fury
+{
+  LaunchOptions LaunchOptions::parse(int argc, const char* const* argv)
+  {
+    LaunchOptions options;
+    stress_scene::Config stress;
+    bool stress_requested = false;
+    bool stress_tuned = false;
+    // argv[0] is program name
+    for (int i = 1; i < argc; i++)
+    {
+      const std::string_view arg = argv[i];
+      auto next_value = [&]() { return (i + 1 < argc) ? std::string_view(argv[++i]) : std::string_view(); };
+      if (arg == "--headless")
+      {
+        options.headless = HeadlessContext::OSMESA;
+        const std::string_view context = (i + 1 < argc) ? argv[i + 1] : "";
+        if (context == "osmesa" || context == "egl")
+        {
+          options.headless = context == "egl" ? HeadlessContext::EGL : HeadlessContext::OSMESA;
+          i++;
+        }
+      }
+      else if (arg == "--frames")
+      {
+        const std::string_view count = next_value();
+        options.frame_count = parse_number<uint32_t>(arg, count);
+        if (options.frame_count == 0)
+        {
+          throw std::invalid_argument("--frames expects positive number of frames, got '" + std::string(count) + "'");
+        }
+      }
+      else if (arg == "--stress-scene")
+      {
+        stress.object_count = parse_number<uint32_t>(arg, next_value());
+        stress_requested = true;
+      }
+      else if (arg == "--seed" || arg == "--hierarchy-depth" || arg == "--lights" || arg == "--textures")
+      {
+        const uint32_t value = parse_number<uint32_t>(arg, next_value());
+        uint32_t& field = arg == "--seed" ? stress.seed
+          : arg == "--hierarchy-depth" ? stress.hierarchy_depth
+          : arg == "--lights" ? stress.light_count
+          : stress.texture_count;
+        field = value;
+        stress_tuned = true;
+      }
+      else if (arg == "--animated")
+      {
+        stress.animated_fraction = parse_number<float>(arg, next_value());
+        if (stress.animated_fraction < 0.f || stress.animated_fraction > 1.f)
+        {
+          throw std::invalid_argument("--animated expects fraction in [0, 1]");
+        }
+        stress_tuned = true;
+      }
+      else if (arg == "--model")
+      {
+        const std::string_view file = next_value();
+        if (file.empty())
+        {
+          throw std::invalid_argument("--model expects model file");
+        }
+        stress.model_files.emplace_back(file);
+        stress_tuned = true;
+      }
+      else if (arg == "--benchmark")
+      {
+        options.benchmark = true;
+        if (i + 1 < argc && !std::string_view(argv[i + 1]).starts_with("--"))
+        {
+          options.benchmark_report = argv[++i];
+        }
+      }
+      else
+      {
+        throw std::invalid_argument("Unknown argument '" + std::string(arg) + "'");
+      }
+    }
+    if (stress_requested)
+    {
+      options.stress_scene = stress;
+    }
+    else if (stress_tuned)
+    {
+      throw std::invalid_argument("Stress scene options require --stress-scene");
+    }
+    if (options.benchmark && options.frame_count == 0)
+    {
+      options.frame_count = default_benchmark_frames;
+    }
+    return options;
+  }
+}
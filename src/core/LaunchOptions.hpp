@@ -0,0 +1,37 @@
+#pragma once
+
+#include "StressScene.hpp"
+#include <optional>
+#include <string>
+#include <cstdint>
+
+namespace fury
+{
+  // Command line of the engine:
+  //   --headless [osmesa|egl]  render without display, OSMesa (llvmpipe) by default
+  //   --frames N               render N frames, report throughput and exit
+  //   --stress-scene N         generated scene of N objects instead of the default one, tuned by:
+  //     --seed S, --hierarchy-depth D, --animated FRACTION, --lights N, --textures N, --model FILE (repeatable)
+  //   --benchmark [FILE]       fly camera along scripted path and report frame time percentiles, CPU time of
+  //                            frame phases and uploaded bytes. JSON report is written to FILE if given
+  struct LaunchOptions
+  {
+    enum class HeadlessContext
+    {
+      NONE,
+      OSMESA,
+      EGL
+    };
+    // frames of benchmark run without --frames
+    constexpr static uint32_t default_benchmark_frames = 600;
+    HeadlessContext headless = HeadlessContext::NONE;
+    // 0 - until window is closed
+    uint32_t frame_count = 0;
+    std::optional<stress_scene::Config> stress_scene;
+    bool benchmark = false;
+    std::string benchmark_report;
+    bool is_headless() const { return headless != HeadlessContext::NONE; }
+    // throws std::invalid_argument on unknown or malformed argument
+    static LaunchOptions parse(int argc, const char* const* argv);
+  };
+}
@@ -21,7 +21,7 @@ namespace fury
     glm::vec4 ambient = glm::vec4(1.f);
     glm::vec4 diffuse = glm::vec4(1.f);
     glm::vec4 specular = glm::vec4(1.f);
-    // matrix for transformation to light space
+    // unused since shadow cascades are fitted per frame, kept for layout of serialized scenes
     glm::mat4 shadow_matrix;
 
     // attenuation info for point light
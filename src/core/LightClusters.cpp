@@ -0,0 +1,216 @@
+#include "LightClusters.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  struct Sphere
+  {
+    glm::vec3 center;
+    float radius = 0.f;
+  };
+
+  // world space sphere that bounds light volume
+  Sphere get_bounding_sphere(const fury::LightDescription& light, float range)
+  {
+    const glm::vec3 pos = glm::vec3(light.position);
+    // only smooth spot light has no effect outside of its outer cone
+    if (light.type != fury::LightType::SPOT || !light.smoothSpotLight || glm::length(glm::vec3(light.dir)) == 0.f)
+    {
+      return { pos, range };
+    }
+    const glm::vec3 dir = glm::normalize(glm::vec3(light.dir));
+    const float cos_angle = std::clamp(light.outerCutoff, 0.f, 1.f);
+    if (cos_angle < std::sqrt(0.5f))
+    {
+      // wide cone, sphere over its base disk
+      const float sin_angle = std::sqrt(1.f - cos_angle * cos_angle);
+      return { pos + dir * range * cos_angle, range * sin_angle };
+    }
+    // narrow cone, sphere through apex and base rim
+    const float radius = range / (2.f * cos_angle);
+    return { pos + dir * radius, radius };
+  }
+
+  bool intersects(const Sphere& sphere, const fury::BoundingBox& bbox)
+  {
+    const glm::vec3 closest = glm::clamp(sphere.center, bbox.min(), bbox.max());
+    const glm::vec3 d = closest - sphere.center;
+    return glm::dot(d, d) <= sphere.radius * sphere.radius;
+  }
+
+  // point of the ray through ndc point at view space depth
+  glm::vec3 unproject_at_depth(const glm::mat4& inv_projection, float ndc_x, float ndc_y, float depth)
+  {
+    const glm::vec4 near_h = inv_projection * glm::vec4(ndc_x, ndc_y, -1.f, 1.f);
+    const glm::vec4 far_h = inv_projection * glm::vec4(ndc_x, ndc_y, 1.f, 1.f);
+    const glm::vec3 near_p = glm::vec3(near_h) / near_h.w;
+    const glm::vec3 far_p = glm::vec3(far_h) / far_h.w;
+    const float t = (depth + near_p.z) / (near_p.z - far_p.z);
+    return near_p + (far_p - near_p) * t;
+  }
+}
+
+namespace fury
+{
+  namespace light_clusters
+  {
+    float get_light_range(const LightDescription& light)
+    {
+      if (light.type == LightType::DIRECTIONAL)
+      {
+        return -1.f;
+      }
+      // quadratic * d^2 + linear * d + constant = 1 / cutoff
+      const float c = light.constant - 1.f / attenuation_cutoff;
+      if (light.quadratic > 0.f)
+      {
+        return (-light.linear + std::sqrt(light.linear * light.linear - 4.f * light.quadratic * c)) / (2.f * light.quadratic);
+      }
+      if (light.linear > 0.f)
+      {
+        return -c / light.linear;
+      }
+      return -1.f;
+    }
+
+    uint32_t get_slice(float view_depth, float znear, float zfar)
+    {
+      if (view_depth <= znear)
+      {
+        return 0;
+      }
+      const float slice = std::log(view_depth / znear) / std::log(zfar / znear) * grid_z;
+      return std::min(static_cast<uint32_t>(slice), grid_z - 1);
+    }
+
+    float get_slice_near(uint32_t slice, float znear, float zfar)
+    {
+      return znear * std::pow(zfar / znear, static_cast<float>(slice) / grid_z);
+    }
+
+    uint32_t get_cluster_index(uint32_t x, uint32_t y, uint32_t z)
+    {
+      return x + grid_x * (y + grid_y * z);
+    }
+
+    std::vector<BoundingBox> compute_cluster_bounds(const glm::mat4& projection, float znear, float zfar)
+    {
+      const glm::mat4 inv_projection = glm::inverse(projection);
+      std::vector<BoundingBox> bounds(count);
+      for (uint32_t z = 0; z < grid_z; z++)
+      {
+        const float depths[2] = { get_slice_near(z, znear, zfar), get_slice_near(z + 1, znear, zfar) };
+        for (uint32_t y = 0; y < grid_y; y++)
+        {
+          for (uint32_t x = 0; x < grid_x; x++)
+          {
+            glm::vec3 min(std::numeric_limits<float>::max());
+            glm::vec3 max(std::numeric_limits<float>::lowest());
+            for (uint32_t corner = 0; corner < 8; corner++)
+            {
+              const float ndc_x = -1.f + 2.f * (x + (corner & 1)) / grid_x;
+              const float ndc_y = -1.f + 2.f * (y + ((corner >> 1) & 1)) / grid_y;
+              const glm::vec3 p = unproject_at_depth(inv_projection, ndc_x, ndc_y, depths[corner >> 2]);
+              min = glm::min(min, p);
+              max = glm::max(max, p);
+            }
+            bounds[get_cluster_index(x, y, z)].init(min, max);
+          }
+        }
+      }
+      return bounds;
+    }
+
+    void build(const std::vector<LightDescription>& lights, const glm::mat4& view, const glm::mat4& projection,
+      float znear, float zfar, const std::vector<BoundingBox>& cluster_bounds, Grid& grid)
+    {
+      grid.clusters.assign(count, Cluster());
+      grid.light_indices.clear();
+      grid.global_light_count = 0;
+      // (cluster, light) pairs, sorted by cluster afterwards
+      std::vector<std::pair<uint32_t, uint32_t>> assignments;
+      for (uint32_t light_idx = 0; light_idx < lights.size(); light_idx++)
+      {
+        const LightDescription& light = lights[light_idx];
+        const float range = get_light_range(light);
+        if (range < 0.f)
+        {
+          grid.light_indices.push_back(light_idx);
+          grid.global_light_count++;
+          continue;
+        }
+        Sphere sphere = get_bounding_sphere(light, range);
+        sphere.center = glm::vec3(view * glm::vec4(sphere.center, 1.f));
+        const float min_depth = -sphere.center.z - sphere.radius;
+        const float max_depth = -sphere.center.z + sphere.radius;
+        if (max_depth < znear || min_depth > zfar)
+        {
+          continue;
+        }
+        const uint32_t z0 = get_slice(min_depth, znear, zfar);
+        const uint32_t z1 = get_slice(max_depth, znear, zfar);
+        // screen rect of sphere bbox. projection keeps convex shapes in front of camera convex, so corners bound it
+        uint32_t x0 = 0, y0 = 0, x1 = grid_x - 1, y1 = grid_y - 1;
+        glm::vec2 ndc_min(std::numeric_limits<float>::max());
+        glm::vec2 ndc_max(std::numeric_limits<float>::lowest());
+        bool in_front = true;
+        for (uint32_t corner = 0; corner < 8 && in_front; corner++)
+        {
+          const glm::vec3 offset((corner & 1) ? 1.f : -1.f, (corner & 2) ? 1.f : -1.f, (corner & 4) ? 1.f : -1.f);
+          const glm::vec4 clip = projection * glm::vec4(sphere.center + offset * sphere.radius, 1.f);
+          in_front = clip.w > 0.f;
+          ndc_min = glm::min(ndc_min, glm::vec2(clip) / clip.w);
+          ndc_max = glm::max(ndc_max, glm::vec2(clip) / clip.w);
+        }
+        if (in_front)
+        {
+          if (ndc_max.x < -1.f || ndc_max.y < -1.f || ndc_min.x > 1.f || ndc_min.y > 1.f)
+          {
+            continue;
+          }
+          auto to_tile = [](float ndc, uint32_t tiles) {
+            return std::min(static_cast<uint32_t>(std::max((ndc * 0.5f + 0.5f) * tiles, 0.f)), tiles - 1);
+          };
+          x0 = to_tile(ndc_min.x, grid_x);
+          x1 = to_tile(ndc_max.x, grid_x);
+          y0 = to_tile(ndc_min.y, grid_y);
+          y1 = to_tile(ndc_max.y, grid_y);
+        }
+        for (uint32_t z = z0; z <= z1; z++)
+        {
+          for (uint32_t y = y0; y <= y1; y++)
+          {
+            for (uint32_t x = x0; x <= x1; x++)
+            {
+              const uint32_t cluster_idx = get_cluster_index(x, y, z);
+              if (intersects(sphere, cluster_bounds[cluster_idx]))
+              {
+                assignments.emplace_back(cluster_idx, light_idx);
+              }
+            }
+          }
+        }
+      }
+      // counting sort by cluster, lights of each cluster stay in scene order
+      for (const auto& [cluster_idx, light_idx] : assignments)
+      {
+        grid.clusters[cluster_idx].count++;
+      }
+      uint32_t offset = grid.global_light_count;
+      for (Cluster& cluster : grid.clusters)
+      {
+        cluster.offset = offset;
+        offset += cluster.count;
+        cluster.count = 0;
+      }
+      grid.light_indices.resize(offset);
+      for (const auto& [cluster_idx, light_idx] : assignments)
+      {
+        Cluster& cluster = grid.clusters[cluster_idx];
+        grid.light_indices[cluster.offset + cluster.count++] = light_idx;
+      }
+    }
+  }
+}
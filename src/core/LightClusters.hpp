@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Light.hpp"
+#include "ge/BoundingBox.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace fury
+{
+  // Clustered light assignment. View frustum is split into grid of clusters (screen tiles x exponential depth slices),
+  // each cluster gets list of lights that reach it, so fragment shader iterates only over lights of its cluster
+  namespace light_clusters
+  {
+    constexpr uint32_t grid_x = 16;
+    constexpr uint32_t grid_y = 9;
+    constexpr uint32_t grid_z = 24;
+    constexpr uint32_t count = grid_x * grid_y * grid_z;
+    // light is cut off where its attenuation drops below this
+    constexpr float attenuation_cutoff = 1.f / 256.f;
+    struct Cluster
+    {
+      // into light indices
+      uint32_t offset = 0;
+      uint32_t count = 0;
+    };
+    struct Grid
+    {
+      std::vector<Cluster> clusters;
+      // lights that reach everything (directional ones or without attenuation) go first and aren't in clusters
+      std::vector<uint32_t> light_indices;
+      uint32_t global_light_count = 0;
+    };
+    // distance where attenuation reaches cutoff, negative if light is not attenuated
+    float get_light_range(const LightDescription& light);
+    // depth slice of view space depth, slices grow exponentially from znear to zfar
+    uint32_t get_slice(float view_depth, float znear, float zfar);
+    float get_slice_near(uint32_t slice, float znear, float zfar);
+    uint32_t get_cluster_index(uint32_t x, uint32_t y, uint32_t z);
+    // view space bounds of clusters, they depend only on projection. works for perspective and orthographic projections
+    std::vector<BoundingBox> compute_cluster_bounds(const glm::mat4& projection, float znear, float zfar);
+    // bins lights by their bounding spheres. spot lights with smooth edge are bound by their cone
+    void build(const std::vector<LightDescription>& lights, const glm::mat4& view, const glm::mat4& projection,
+      float znear, float zfar, const std::vector<BoundingBox>& cluster_bounds, Grid& grid);
+  }
+}
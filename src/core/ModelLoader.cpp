@@ -2,6 +2,7 @@
 #include "Logger.hpp"
 #include "AssetManager.hpp"
 #include "TextureManager.hpp"
+#include "Profiler.hpp"
 #include <assimp/Importer.hpp>
 
 namespace
@@ -17,6 +18,7 @@ namespace fury
 {
   bool ModelLoader::load(const std::string& file, unsigned int flags, Object3D& model)
   {
+    FURY_PROFILE_SCOPE("ModelLoader::load");
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(file, flags);
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
@@ -33,6 +35,7 @@ namespace fury
       Logger::info("Loaded model {}. Vertex count {}, face count {}.", file,
                    model.get_geometry_metadata().vert_count_total, model.get_geometry_metadata().face_count_total);
       ::center_around_origin(model);
+      model.generate_lods();
       // set some shading mode so that textures will be applied (if present) during rendering
       model.set_shading_mode(ShadingProcessor::ShadingMode::SMOOTH_SHADING);
       model.set_is_fixed_shading(true);
@@ -0,0 +1,113 @@
+#include "Profiler.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  struct ThreadBuffer
+  {
+    uint32_t tid = 0;
+    std::vector<fury::Profiler::Record> records;
+    size_t next = 0;
+    size_t count = 0;
+  };
+
+  std::mutex buffers_mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  thread_local ThreadBuffer* thread_buffer = nullptr;
+
+  ThreadBuffer* register_thread()
+  {
+    std::lock_guard lock(buffers_mutex);
+    auto& buffer = buffers.emplace_back(std::make_unique<ThreadBuffer>());
+    buffer->tid = static_cast<uint32_t>(buffers.size());
+    buffer->records.resize(fury::Profiler::thread_buffer_capacity);
+    return buffer.get();
+  }
+
+  void write_escaped(std::ostream& os, const char* str)
+  {
+    for (; *str; str++)
+    {
+      if (*str == '"' || *str == '\\')
+      {
+        os << '\\';
+      }
+      os << *str;
+    }
+  }
+}
+
+namespace fury
+{
+  int64_t Profiler::now_ns()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void Profiler::record(const char* name, int64_t start_ns, int64_t end_ns)
+  {
+    if (!thread_buffer)
+    {
+      thread_buffer = register_thread();
+    }
+    ThreadBuffer& buffer = *thread_buffer;
+    buffer.records[buffer.next] = { name, start_ns, end_ns - start_ns };
+    buffer.next = (buffer.next + 1) % thread_buffer_capacity;
+    buffer.count = std::min(buffer.count + 1, thread_buffer_capacity);
+  }
+
+  void Profiler::write_chrome_trace(std::ostream& os)
+  {
+    std::lock_guard lock(buffers_mutex);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : buffers)
+    {
+      // oldest first
+      const size_t begin = (buffer->next + thread_buffer_capacity - buffer->count) % thread_buffer_capacity;
+      for (size_t i = 0; i < buffer->count; i++)
+      {
+        const Record& rec = buffer->records[(begin + i) % thread_buffer_capacity];
+        os << (first ? "" : ",") << "\n{\"name\":\"";
+        write_escaped(os, rec.name);
+        // timestamps are in microseconds
+        os << "\",\"ph\":\"X\",\"ts\":" << rec.start_ns / 1000 << '.' << std::setfill('0') << std::setw(3)
+           << rec.start_ns % 1000 << ",\"dur\":" << rec.duration_ns / 1000 << '.' << std::setw(3)
+           << rec.duration_ns % 1000 << ",\"pid\":0,\"tid\":" << buffer->tid << '}';
+        first = false;
+      }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  }
+
+  bool Profiler::dump_chrome_trace(const std::filesystem::path& path)
+  {
+    std::ofstream ofs(path);
+    if (!ofs)
+    {
+      Logger::error("Failed to open {} for profiler trace", path.string());
+      return false;
+    }
+    write_chrome_trace(ofs);
+    Logger::info("Profiler trace written to {}", path.string());
+    return true;
+  }
+
+  void Profiler::clear()
+  {
+    std::lock_guard lock(buffers_mutex);
+    for (const auto& buffer : buffers)
+    {
+      buffer->next = 0;
+      buffer->count = 0;
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+#include <cstdint>
+
+#ifdef FURY_ENABLE_PROFILER
+#define FURY_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FURY_PROFILE_CONCAT(a, b) FURY_PROFILE_CONCAT_IMPL(a, b)
+// name must outlive the profiler, e.g. string literal, only the pointer is recorded
+#define FURY_PROFILE_SCOPE(name) ::fury::ProfileScope FURY_PROFILE_CONCAT(fury_profile_scope_, __LINE__)(name)
+#else
+#define FURY_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+namespace fury
+{
+  // CPU time of scopes, recorded into ring buffer of calling thread. Only the first record of a thread takes a lock to
+  // register its buffer, when buffer is full oldest records are overwritten. Buffers outlive their threads
+  class Profiler
+  {
+  public:
+    constexpr static size_t thread_buffer_capacity = 1 << 16;
+    struct Record
+    {
+      const char* name = nullptr;
+      int64_t start_ns = 0;
+      int64_t duration_ns = 0;
+    };
+    static int64_t now_ns();
+    static void record(const char* name, int64_t start_ns, int64_t end_ns);
+    // Chrome trace event format, opens in chrome://tracing and Perfetto.
+    // other threads must not record while trace is written
+    static void write_chrome_trace(std::ostream& os);
+    static bool dump_chrome_trace(const std::filesystem::path& path);
+    static void clear();
+  };
+
+  class ProfileScope
+  {
+  public:
+    explicit ProfileScope(const char* name) : m_name(name), m_start_ns(Profiler::now_ns()) {}
+    ~ProfileScope() { Profiler::record(m_name, m_start_ns, Profiler::now_ns()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+  private:
+    const char* m_name;
+    int64_t m_start_ns;
+  };
+}
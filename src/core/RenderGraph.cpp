@@ -0,0 +1,378 @@
+#include "RenderGraph.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  GLenum get_attachment_point(GLenum format, int& color_idx)
+  {
+    switch (format)
+    {
+    case GL_DEPTH24_STENCIL8:
+    case GL_DEPTH32F_STENCIL8:
+      return GL_DEPTH_STENCIL_ATTACHMENT;
+    case GL_DEPTH_COMPONENT16:
+    case GL_DEPTH_COMPONENT24:
+    case GL_DEPTH_COMPONENT32F:
+      return GL_DEPTH_ATTACHMENT;
+    default:
+      return GL_COLOR_ATTACHMENT0 + color_idx++;
+    }
+  }
+}
+
+namespace fury
+{
+  void RenderGraph::PassBuilder::read(ResourceId res)
+  {
+    m_graph.m_passes[m_pass].reads.push_back(res);
+    m_graph.m_resources[res].readers.push_back(m_pass);
+  }
+
+  void RenderGraph::PassBuilder::attach(ResourceId res)
+  {
+    m_graph.m_passes[m_pass].attachments.push_back(res);
+    m_graph.m_resources[res].writers.push_back(m_pass);
+  }
+
+  void RenderGraph::PassBuilder::set_side_effect()
+  {
+    m_graph.m_passes[m_pass].side_effect = true;
+  }
+
+  RenderGraph::~RenderGraph()
+  {
+    for (PhysicalTexture& texture : m_textures)
+    {
+      glDeleteTextures(1, &texture.id.id);
+    }
+    for (Framebuffer& fbo : m_framebuffers)
+    {
+      glDeleteFramebuffers(1, &fbo.id.id);
+    }
+  }
+
+  void RenderGraph::reset()
+  {
+    m_resources.clear();
+    m_passes.clear();
+    m_order.clear();
+    m_physical_descs.clear();
+  }
+
+  RenderGraph::ResourceId RenderGraph::create_texture(std::string name, const TextureDesc& desc)
+  {
+    Resource& res = m_resources.emplace_back();
+    res.name = std::move(name);
+    res.desc = desc;
+    return static_cast<ResourceId>(m_resources.size() - 1);
+  }
+
+  RenderGraph::ResourceId RenderGraph::import_framebuffer(std::string name, GLuint fbo)
+  {
+    Resource& res = m_resources.emplace_back();
+    res.name = std::move(name);
+    res.imported = true;
+    res.imported_fbo = fbo;
+    return static_cast<ResourceId>(m_resources.size() - 1);
+  }
+
+  RenderGraph::PassId RenderGraph::add_pass(std::string name, const SetupFunc& setup, ExecuteFunc execute)
+  {
+    const PassId id = static_cast<PassId>(m_passes.size());
+    Pass& pass = m_passes.emplace_back();
+    pass.name = std::move(name);
+    pass.execute = std::move(execute);
+    PassBuilder builder(*this, id);
+    setup(builder);
+    return id;
+  }
+
+  bool RenderGraph::compile()
+  {
+    cull();
+    if (!sort())
+    {
+      return false;
+    }
+    assign_physical_textures();
+    return true;
+  }
+
+  void RenderGraph::cull()
+  {
+    std::vector<PassId> worklist;
+    for (PassId id = 0; id < m_passes.size(); id++)
+    {
+      Pass& pass = m_passes[id];
+      pass.alive = pass.side_effect ||
+        std::any_of(pass.attachments.begin(), pass.attachments.end(), [this](ResourceId res) { return m_resources[res].imported; });
+      if (pass.alive)
+      {
+        worklist.push_back(id);
+      }
+    }
+    // pass is needed if it writes what needed pass reads or renders on top of
+    while (!worklist.empty())
+    {
+      const Pass& pass = m_passes[worklist.back()];
+      const PassId pass_id = worklist.back();
+      worklist.pop_back();
+      auto visit = [&](ResourceId res) {
+        for (PassId writer : m_resources[res].writers)
+        {
+          if (writer != pass_id && !m_passes[writer].alive)
+          {
+            m_passes[writer].alive = true;
+            worklist.push_back(writer);
+          }
+        }
+      };
+      std::for_each(pass.reads.begin(), pass.reads.end(), visit);
+      std::for_each(pass.attachments.begin(), pass.attachments.end(), visit);
+    }
+  }
+
+  bool RenderGraph::sort()
+  {
+    // writers of resource keep declaration order, readers go after all writers
+    std::vector<std::vector<PassId>> successors(m_passes.size());
+    std::vector<uint32_t> in_degree(m_passes.size(), 0);
+    auto add_edge = [&](PassId from, PassId to) {
+      if (from != to && m_passes[from].alive && m_passes[to].alive)
+      {
+        successors[from].push_back(to);
+        in_degree[to]++;
+      }
+    };
+    for (const Resource& res : m_resources)
+    {
+      for (size_t i = 1; i < res.writers.size(); i++)
+      {
+        add_edge(res.writers[i - 1], res.writers[i]);
+      }
+      for (PassId reader : res.readers)
+      {
+        if (std::find(res.writers.begin(), res.writers.end(), reader) != res.writers.end())
+        {
+          // reader that renders to resource too is ordered among writers
+          continue;
+        }
+        for (PassId writer : res.writers)
+        {
+          add_edge(writer, reader);
+        }
+      }
+    }
+    // among ready passes the one declared first goes first, so independent passes keep declaration order
+    m_order.clear();
+    std::vector<bool> scheduled(m_passes.size(), false);
+    const size_t alive_count = std::count_if(m_passes.begin(), m_passes.end(), [](const Pass& pass) { return pass.alive; });
+    while (m_order.size() < alive_count)
+    {
+      PassId next = static_cast<PassId>(m_passes.size());
+      for (PassId id = 0; id < m_passes.size(); id++)
+      {
+        if (m_passes[id].alive && !scheduled[id] && in_degree[id] == 0)
+        {
+          next = id;
+          break;
+        }
+      }
+      if (next == m_passes.size())
+      {
+        Logger::error("RenderGraph: passes have cyclic dependencies.");
+        m_order.clear();
+        return false;
+      }
+      scheduled[next] = true;
+      m_order.push_back(next);
+      for (PassId succ : successors[next])
+      {
+        in_degree[succ]--;
+      }
+    }
+    return true;
+  }
+
+  void RenderGraph::assign_physical_textures()
+  {
+    struct Lifetime
+    {
+      ResourceId res = 0;
+      size_t first = 0;
+      size_t last = 0;
+    };
+    std::vector<Lifetime> lifetimes;
+    std::vector<int> lifetime_idx(m_resources.size(), -1);
+    for (size_t pos = 0; pos < m_order.size(); pos++)
+    {
+      const Pass& pass = m_passes[m_order[pos]];
+      auto touch = [&](ResourceId res) {
+        if (m_resources[res].imported)
+        {
+          return;
+        }
+        if (lifetime_idx[res] < 0)
+        {
+          lifetime_idx[res] = static_cast<int>(lifetimes.size());
+          lifetimes.push_back({ res, pos, pos });
+        }
+        lifetimes[lifetime_idx[res]].last = pos;
+      };
+      std::for_each(pass.reads.begin(), pass.reads.end(), touch);
+      std::for_each(pass.attachments.begin(), pass.attachments.end(), touch);
+    }
+    for (Resource& res : m_resources)
+    {
+      res.physical = no_physical_texture;
+    }
+    // lifetimes are already sorted by first use. texture is reused if its last user runs before first user of resource
+    m_physical_descs.clear();
+    std::vector<size_t> physical_last_use;
+    for (const Lifetime& lifetime : lifetimes)
+    {
+      Resource& res = m_resources[lifetime.res];
+      for (size_t i = 0; i < m_physical_descs.size(); i++)
+      {
+        if (m_physical_descs[i] == res.desc && physical_last_use[i] < lifetime.first)
+        {
+          res.physical = static_cast<int>(i);
+          break;
+        }
+      }
+      if (res.physical == no_physical_texture)
+      {
+        res.physical = static_cast<int>(m_physical_descs.size());
+        m_physical_descs.push_back(res.desc);
+        physical_last_use.push_back(0);
+      }
+      physical_last_use[res.physical] = lifetime.last;
+    }
+  }
+
+  void RenderGraph::realize_textures()
+  {
+    // pool textures that don't match are recreated, the rest of pool is released
+    for (size_t i = m_physical_descs.size(); i < m_textures.size(); i++)
+    {
+      glDeleteTextures(1, &m_textures[i].id.id);
+    }
+    m_textures.resize(m_physical_descs.size());
+    for (size_t i = 0; i < m_physical_descs.size(); i++)
+    {
+      PhysicalTexture& texture = m_textures[i];
+      const TextureDesc& desc = m_physical_descs[i];
+      if (texture.id != 0 && texture.desc == desc)
+      {
+        continue;
+      }
+      glDeleteTextures(1, &texture.id.id);
+      texture.desc = desc;
+      glGenTextures(1, &texture.id.id);
+      if (desc.samples > 1)
+      {
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, texture.id);
+        glTexStorage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, desc.samples, desc.format, desc.width, desc.height, GL_TRUE);
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+      }
+      else
+      {
+        glBindTexture(GL_TEXTURE_2D, texture.id);
+        glTexStorage2D(GL_TEXTURE_2D, 1, desc.format, desc.width, desc.height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+      }
+    }
+  }
+
+  GLuint RenderGraph::prepare_framebuffer(size_t order_idx, const Pass& pass)
+  {
+    if (pass.attachments.empty())
+    {
+      return 0;
+    }
+    if (m_resources[pass.attachments.front()].imported)
+    {
+      assert(pass.attachments.size() == 1);
+      return m_resources[pass.attachments.front()].imported_fbo;
+    }
+    Framebuffer& fbo = m_framebuffers[order_idx];
+    std::vector<GLuint> attachments;
+    for (ResourceId res : pass.attachments)
+    {
+      attachments.push_back(get_texture(res));
+    }
+    if (fbo.id != 0 && fbo.attachments == attachments)
+    {
+      return fbo.id;
+    }
+    glDeleteFramebuffers(1, &fbo.id.id);
+    glGenFramebuffers(1, &fbo.id.id);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo.id);
+    int color_idx = 0;
+    for (ResourceId res : pass.attachments)
+    {
+      const TextureDesc& desc = m_resources[res].desc;
+      const GLenum target = desc.samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+      glFramebufferTexture2D(GL_FRAMEBUFFER, ::get_attachment_point(desc.format, color_idx), target, get_texture(res), 0);
+    }
+    std::vector<GLenum> draw_buffers;
+    for (int i = 0; i < color_idx; i++)
+    {
+      draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+    }
+    if (draw_buffers.empty())
+    {
+      glDrawBuffer(GL_NONE);
+    }
+    else
+    {
+      glDrawBuffers(static_cast<GLsizei>(draw_buffers.size()), draw_buffers.data());
+    }
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+      Logger::error("RenderGraph: framebuffer of pass {} is not complete.", pass.name);
+    }
+    fbo.attachments = std::move(attachments);
+    return fbo.id;
+  }
+
+  void RenderGraph::execute()
+  {
+    realize_textures();
+    if (m_framebuffers.size() < m_order.size())
+    {
+      m_framebuffers.resize(m_order.size());
+    }
+    // framebuffers of all passes are ready before first pass runs, so passes can read from each other's framebuffers
+    m_pass_framebuffers.assign(m_passes.size(), 0);
+    for (size_t i = 0; i < m_order.size(); i++)
+    {
+      m_pass_framebuffers[m_order[i]] = prepare_framebuffer(i, m_passes[m_order[i]]);
+    }
+    for (PassId id : m_order)
+    {
+      const Pass& pass = m_passes[id];
+      if (!pass.attachments.empty())
+      {
+        glBindFramebuffer(GL_FRAMEBUFFER, m_pass_framebuffers[id]);
+      }
+      pass.execute();
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  }
+
+  GLuint RenderGraph::get_texture(ResourceId res) const
+  {
+    const int physical = m_resources[res].physical;
+    return physical == no_physical_texture ? 0 : m_textures[physical].id.id;
+  }
+
+  GLuint RenderGraph::get_framebuffer(PassId pass) const
+  {
+    return m_pass_framebuffers[pass];
+  }
+}
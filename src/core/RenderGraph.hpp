@@ -0,0 +1,120 @@
+#pragma once
+
+#include "opengl/OpenGLObject.hpp"
+#include <glad/glad.h>
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+
+namespace fury
+{
+  // Frame described as passes that declare textures they read and render to. Graph is rebuilt every frame:
+  // compile() orders passes by their dependencies, culls passes that contribute neither to imported framebuffers
+  // nor to side effects and maps transient textures to physical ones, so textures with the same description and
+  // disjoint lifetimes share memory. Physical textures are pooled between frames.
+  // Every reader of texture sees all writes to it, so single resource can't be ping-ponged.
+  class RenderGraph
+  {
+  public:
+    using ResourceId = uint32_t;
+    using PassId = uint32_t;
+    struct TextureDesc
+    {
+      int width = 0;
+      int height = 0;
+      GLenum format = GL_RGBA8;
+      // more than 1 makes multisampled texture
+      int samples = 1;
+      bool operator==(const TextureDesc&) const = default;
+    };
+    class PassBuilder
+    {
+    public:
+      // pass samples or blits from resource
+      void read(ResourceId res);
+      // resource is render target of pass framebuffer. imported framebuffer can't be combined with other targets
+      void attach(ResourceId res);
+      // pass is kept even if nothing reads what it renders
+      void set_side_effect();
+    private:
+      PassBuilder(RenderGraph& graph, PassId pass) : m_graph(graph), m_pass(pass) {}
+      friend class RenderGraph;
+    private:
+      RenderGraph& m_graph;
+      PassId m_pass;
+    };
+    using SetupFunc = std::function<void(PassBuilder&)>;
+    using ExecuteFunc = std::function<void()>;
+    constexpr static int no_physical_texture = -1;
+    FURY_OnlyMovable(RenderGraph)
+    RenderGraph() = default;
+    ~RenderGraph();
+    // drops passes and resources of previous frame, physical textures stay in pool
+    void reset();
+    ResourceId create_texture(std::string name, const TextureDesc& desc);
+    // framebuffer owned by someone else, e.g. window one. passes that render to it are always kept
+    ResourceId import_framebuffer(std::string name, GLuint fbo);
+    PassId add_pass(std::string name, const SetupFunc& setup, ExecuteFunc execute);
+    // returns false if dependencies have a cycle
+    bool compile();
+    // binds framebuffer of each pass that survived culling and runs it
+    void execute();
+    // valid after compile
+    const std::vector<PassId>& get_execution_order() const { return m_order; }
+    bool is_culled(PassId pass) const { return !m_passes[pass].alive; }
+    // same index of two resources means they are aliased
+    int get_physical_index(ResourceId res) const { return m_resources[res].physical; }
+    size_t get_physical_count() const { return m_physical_descs.size(); }
+    // valid during execute
+    GLuint get_texture(ResourceId res) const;
+    GLuint get_framebuffer(PassId pass) const;
+  private:
+    struct Resource
+    {
+      std::string name;
+      TextureDesc desc;
+      bool imported = false;
+      GLuint imported_fbo = 0;
+      // passes in declaration order
+      std::vector<PassId> writers;
+      std::vector<PassId> readers;
+      int physical = no_physical_texture;
+    };
+    struct Pass
+    {
+      std::string name;
+      ExecuteFunc execute;
+      std::vector<ResourceId> reads;
+      std::vector<ResourceId> attachments;
+      bool side_effect = false;
+      bool alive = false;
+    };
+    struct PhysicalTexture
+    {
+      TextureDesc desc;
+      OpenGLIdWrapper<GLuint> id;
+    };
+    struct Framebuffer
+    {
+      OpenGLIdWrapper<GLuint> id;
+      // textures attached last time, framebuffer is reattached when they change
+      std::vector<GLuint> attachments;
+    };
+  private:
+    void cull();
+    bool sort();
+    void assign_physical_textures();
+    void realize_textures();
+    GLuint prepare_framebuffer(size_t order_idx, const Pass& pass);
+  private:
+    std::vector<Resource> m_resources;
+    std::vector<Pass> m_passes;
+    std::vector<PassId> m_order;
+    std::vector<TextureDesc> m_physical_descs;
+    std::vector<PhysicalTexture> m_textures;
+    // by position in execution order
+    std::vector<Framebuffer> m_framebuffers;
+    std::vector<GLuint> m_pass_framebuffers;
+  };
+}
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <cstddef>
+
 namespace fury
 {
   struct RenderInfo
   {
     float frame_time = 0.f;
     int fps = 0;
+    // frame pacing of fps limiter, in seconds. target is 0 without limit
+    float target_frame_time = 0.f;
+    float achieved_frame_time = 0.f;
+    float frame_time_jitter = 0.f;
+    // written by CPU into buffers during last frame
+    size_t upload_bytes = 0;
   };
 }
@@ -11,9 +11,18 @@
 #include "Event.hpp"
 #include "ge/Polyline.hpp"
 #include "Globals.hpp"
+#include "Profiler.hpp"
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <numeric>
+#include <algorithm>
+#include <unordered_map>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <cstddef>
+#include <utility>
 
 namespace
 {
@@ -24,17 +33,19 @@ namespace
 		vao.link_attrib(2, 4, GL_FLOAT, sizeof(fury::Vertex), (void*)(sizeof(GLfloat) * 6));   // color
 		vao.link_attrib(3, 2, GL_FLOAT, sizeof(fury::Vertex), (void*)(sizeof(GLfloat) * 10));  // texture
 	}
-  constexpr static GLuint cube_lines_indices[24] = {
-      0, 1, 1, 2, 2, 3, 3, 0, // front
-      4, 5, 5, 6, 6, 7, 7, 4, // back
-      0, 4, 3, 7, 1, 5, 2, 6
-  };
-
-  constexpr static float unit_cube[24] =
+	// shaders get the same inputs, except that normal is octahedral encoded in xy
+	void set_packed_vertex_attributes(fury::VertexArrayObject& vao)
+	{
+		using fury::PackedVertex;
+		vao.link_attrib(0, 3, GL_UNSIGNED_SHORT, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position), true);
+		vao.link_attrib(1, 2, GL_SHORT, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal), true);
+		vao.link_attrib(2, 4, GL_UNSIGNED_BYTE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, color), true);
+		vao.link_attrib(3, 2, GL_HALF_FLOAT, sizeof(PackedVertex), (void*)offsetof(PackedVertex, uv));
+	}
+  bool is_visible(const fury::Frustum& fr, const fury::Object3D* obj, const glm::mat4& transform)
   {
-    -0.5, -0.5, 0.5, 0.5, -0.5, 0.5, 0.5, 0.5, 0.5, -0.5, 0.5, 0.5,
-    -0.5, -0.5, -0.5, 0.5, -0.5, -0.5, 0.5, 0.5, -0.5, -0.5, 0.5, -0.5
-  };
+    return fr.is_inside(obj->get_bbox().transformed(transform));
+  }
 }
 
 namespace fury
@@ -43,9 +54,22 @@ namespace fury
   {
   }
 
-  GeometryPass::GeometryPass(Scene* scene, int shadow_map_texture) : RenderPass(scene)
+  GeometryPass::GeometryPass(Scene* scene) : RenderPass(scene)
   {
-    m_shadow_map_texture = shadow_map_texture;
+    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::DEFAULT);
+    m_view_pos_uniform = UniformHandle<glm::vec3>(shader, "viewPos");
+    m_num_lights_uniform = UniformHandle<int>(shader, "numLights");
+    m_packed_vertices_uniform = UniformHandle<int>(shader, "packedVertices");
+    m_num_global_lights_uniform = UniformHandle<int>(shader, "numGlobalLights");
+    m_cluster_params_uniform = UniformHandle<glm::vec4>(shader, "clusterParams");
+    m_gbuffer_packed_vertices_uniform = UniformHandle<int>(&ShaderStorage::get(ShaderStorage::ShaderType::GBUFFER), "packedVertices");
+    m_outline_model_matrix_uniform = UniformHandle<glm::mat4>(&ShaderStorage::get(ShaderStorage::ShaderType::OUTLINING), "modelMatrix");
+    Shader* culling_shader = &ShaderStorage::get(ShaderStorage::ShaderType::CULLING);
+    m_cull_commands_count_uniform = UniformHandle<unsigned int>(culling_shader, "commandsCount");
+    m_cull_command_words_uniform = UniformHandle<unsigned int>(culling_shader, "commandWords");
+    m_cull_input_offset_uniform = UniformHandle<unsigned int>(culling_shader, "inputOffset");
+    m_cull_output_offset_uniform = UniformHandle<unsigned int>(culling_shader, "outputOffset");
+    m_cull_group_uniform = UniformHandle<unsigned int>(culling_shader, "group");
     BindChainFIFO bind_chain({ &m_vao_indices, &m_vbo_indices });
     ::set_default_vertex_attributes(m_vao_indices);
     BindChainFIFO bind_chain2({ &m_vao_arrays, &m_vbo_arrays });
@@ -65,74 +89,320 @@ namespace fury
 
   void GeometryPass::handle_object_change(const ObjectChangeInfo& info)
   {
-    if (info.is_color_change)
+    // color is written to draw data every frame, so its change doesn't touch geometry
+    if (info.is_shading_mode_change && m_object_geometry.contains(info.object))
+    {
+      // shading replaces mesh storage, so object moves to other geometry
+      free_object(info.object);
+      upload_object(info.object);
+      build_material_table();
+    }
+  }
+
+  void GeometryPass::update_light_clusters(const Camera& camera)
+  {
+    FURY_PROFILE_SCOPE("GeometryPass::update_light_clusters");
+    const float znear = camera.get_znear();
+    const float zfar = camera.get_zfar();
+    const glm::mat4& projection = camera.get_projection_matrix();
+    if (projection != m_cluster_projection)
+    {
+      m_cluster_bounds = light_clusters::compute_cluster_bounds(projection, znear, zfar);
+      m_cluster_projection = projection;
+    }
+    light_clusters::build(m_lights_data, camera.get_view_matrix(), projection, znear, zfar, m_cluster_bounds, m_light_grid);
+    const size_t clusters_size = m_light_grid.clusters.size() * sizeof(light_clusters::Cluster);
+    RingBuffer::Allocation clusters_alloc = m_light_clusters_ring.push(m_light_grid.clusters.data(), clusters_size);
+    m_light_clusters_ring.bind_range(9, clusters_alloc.offset, clusters_size);
+    const size_t indices_size = m_light_grid.light_indices.size() * sizeof(uint32_t);
+    if (indices_size > 0)
+    {
+      RingBuffer::Allocation indices_alloc = m_light_indices_ring.push(m_light_grid.light_indices.data(), indices_size);
+      m_light_indices_ring.bind_range(10, indices_alloc.offset, indices_size);
+    }
+    m_num_global_lights_uniform.set(static_cast<int>(m_light_grid.global_light_count));
+    // fragment cluster is found from window coordinates and view depth, slice = log(depth) * scale + bias
+    const glm::vec2 screen_size = camera.get_screen_size();
+    const float depth_scale = light_clusters::grid_z / std::log(zfar / znear);
+    m_cluster_params = glm::vec4(screen_size.x / light_clusters::grid_x, screen_size.y / light_clusters::grid_y,
+      depth_scale, -std::log(znear) * depth_scale);
+    m_cluster_params_uniform.set(m_cluster_params);
+  }
+
+  void GeometryPass::update_lights_data()
+  {
+    const std::vector<const Light*> lights = m_scene->get_active_lights();
+    m_lights_data.clear();
+    m_lights_data.reserve(lights.size());
+    for (const Light* light : lights)
+    {
+      m_lights_data.push_back(light->get_description());
+    }
+  }
+
+  size_t GeometryPass::allocate_from_heap(FreeListAllocator& heap, OpenGLBuffer& buffer, size_t count, size_t unit_size)
+  {
+    std::optional<size_t> offset = heap.allocate(count);
+    if (!offset)
     {
-      const Object3D* obj = info.object;
-      const std::vector<MeshRenderOffsets>& offsets = m_render_offsets.at(obj);
-      BindGuard bg(obj->get_render_config().use_indices ? &m_vbo_indices : &m_vbo_arrays);
-      assert(offsets.size() == obj->mesh_count());
-      for (int i = 0; const MeshRenderOffsets& mesh_offset : offsets)
+      // geometric growth, so that adding objects one by one doesn't reallocate buffer each time
+      const size_t new_capacity = std::max(heap.capacity() * 2, heap.allocated_end() + count);
+      buffer.grow(new_capacity * unit_size);
+      heap.grow(new_capacity);
+      offset = heap.allocate(count);
+      assert(offset.has_value());
+    }
+    return *offset;
+  }
+
+  void GeometryPass::upload_object(const Object3D* obj)
+  {
+    const GeometryKey key = get_geometry_key(obj);
+    m_object_geometry[obj] = key;
+    auto [alloc_it, inserted] = m_allocations.try_emplace(key);
+    GeometryAllocation& alloc = alloc_it->second;
+    alloc.users++;
+    if (!inserted)
+    {
+      return;
+    }
+    const std::vector<Mesh>& meshes = *key.meshes;
+    alloc.use_indices = key.use_indices;
+    for (const Mesh& mesh : meshes)
+    {
+      alloc.vertices.count += mesh.vertices().size();
+      alloc.indices.count += alloc.use_indices ? get_index_count(mesh) : 0;
+    }
+    VertexBufferObject& vbo = alloc.use_indices ? m_vbo_indices : m_vbo_arrays;
+    FreeListAllocator& vertex_heap = alloc.use_indices ? m_vbo_indices_heap : m_vbo_arrays_heap;
+    alloc.vertices.offset = allocate_from_heap(vertex_heap, vbo, alloc.vertices.count, get_vertex_size());
+    alloc.indices.offset = allocate_from_heap(m_ebo_heap, m_ebo, alloc.indices.count, sizeof(GLuint));
+    update_render_offsets(key);
+
+    std::vector<MeshRenderOffsets>& meshes_offsets = m_render_offsets.at(key);
+    for (size_t i = 0; i < meshes_offsets.size(); i++)
+    {
+      const Mesh& mesh = meshes[i];
+      MeshRenderOffsets& mesh_offsets = meshes_offsets[i];
+      if (alloc.use_indices)
       {
-        const Mesh& mesh = obj->get_mesh(i++);
-        if (obj->get_render_config().use_indices)
-        {
-          m_vbo_indices.set_data(mesh.vertices().data(), mesh.vertices().size() * sizeof(Vertex),
-                                 mesh_offset.vbo_indices_offset);
-        }
-        else
+        BindChainFIFO bc({ &m_vao_indices, &m_vbo_indices, &m_ebo });
+        upload_vertices(mesh, mesh_offsets, true);
+        for (uint32_t lod = 0; lod < mesh_offsets.lod_count; lod++)
         {
-          m_vbo_arrays.set_data(mesh.vertices().data(), mesh.vertices().size() * sizeof(Vertex),
-                                mesh_offset.vbo_arrays_offset);
+          const std::vector<GLuint>& indices = mesh.lod_indices(lod);
+          m_ebo.set_data(indices.data(), indices.size() * sizeof(GLuint), mesh_offsets.lods[lod].ebo_offset);
         }
       }
+      else
+      {
+        BindChainFIFO bc({ &m_vao_arrays, &m_vbo_arrays });
+        upload_vertices(mesh, mesh_offsets, false);
+      }
+    }
+  }
+
+  void GeometryPass::upload_vertices(const Mesh& mesh, MeshRenderOffsets& mesh_offsets, bool use_indices)
+  {
+    VertexBufferObject& vbo = use_indices ? m_vbo_indices : m_vbo_arrays;
+    const size_t offset = use_indices ? mesh_offsets.vbo_indices_offset : mesh_offsets.vbo_arrays_offset * get_vertex_size();
+    const std::vector<Vertex>& vertices = mesh.vertices();
+    if (!m_packed_vertices)
+    {
+      mesh_offsets.position_offset = glm::vec3(0.f);
+      mesh_offsets.position_scale = glm::vec3(1.f);
+      vbo.set_data(vertices.data(), vertices.size() * sizeof(Vertex), offset);
+      return;
+    }
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(std::numeric_limits<float>::lowest());
+    for (const Vertex& v : vertices)
+    {
+      min = glm::min(min, v.position);
+      max = glm::max(max, v.position);
     }
-    else if (info.is_shading_mode_change)
+    mesh_offsets.position_offset = vertices.empty() ? glm::vec3(0.f) : min;
+    mesh_offsets.position_scale = vertices.empty() ? glm::vec3(1.f) : max - min;
+    std::vector<PackedVertex> packed;
+    packed.reserve(vertices.size());
+    for (const Vertex& v : vertices)
     {
-      update();
+      packed.push_back(vertex_packing::pack(v, mesh_offsets.position_offset, mesh_offsets.position_scale));
     }
+    vbo.set_data(packed.data(), packed.size() * sizeof(PackedVertex), offset);
   }
 
-  void GeometryPass::update_lights_data()
+  void GeometryPass::set_packed_vertices(bool packed)
   {
-    const std::vector<const Light*> lights = m_scene->get_active_lights();
-    m_lights_data_ssbo.bind();
-    m_lights_data_ssbo.resize_if_smaller(lights.size() * sizeof(LightDescription));
-    m_lights_data_ssbo.set_binding_point(2);
-    for (size_t i = 0; i < lights.size(); i++)
+    std::vector<const Object3D*> objects;
+    objects.reserve(m_object_geometry.size());
+    for (const auto& [obj, key] : m_object_geometry)
+    {
+      objects.push_back(obj);
+    }
+    for (const Object3D* obj : objects)
+    {
+      free_object(obj);
+    }
+    m_packed_vertices = packed;
+    // heaps count vertices, so capacity of the same buffers changes with vertex size
+    m_vbo_indices_heap.reset(m_vbo_indices.get_size() / get_vertex_size());
+    m_vbo_arrays_heap.reset(m_vbo_arrays.get_size() / get_vertex_size());
+    for (auto [vao, vbo] : { std::pair{ &m_vao_indices, &m_vbo_indices }, std::pair{ &m_vao_arrays, &m_vbo_arrays } })
     {
-      m_lights_data_ssbo.set_data(&lights[i]->get_description(), sizeof(LightDescription), i * sizeof(LightDescription));
+      BindChainFIFO bind_chain({ vao, vbo });
+      packed ? ::set_packed_vertex_attributes(*vao) : ::set_default_vertex_attributes(*vao);
     }
-    m_lights_data_ssbo.unbind();
+    for (const Object3D* obj : objects)
+    {
+      upload_object(obj);
+    }
+    // material data of render offsets is lost with geometry
+    build_material_table();
   }
 
-  void GeometryPass::allocate_memory_for_buffers()
+  GeometryPass::GeometryKey GeometryPass::get_geometry_key(const Object3D* obj)
   {
-    size_t vcount_vbo_indices = 0;
-    size_t vcount_vbo_arrays = 0;
-    size_t idx_count = 0;
-    for (const auto& obj : m_scene->get_drawables())
+    return { &obj->get_meshes(), obj->get_render_config().use_indices };
+  }
+
+  size_t GeometryPass::get_index_count(const Mesh& mesh)
+  {
+    size_t count = 0;
+    for (size_t lod = 0; lod < std::min<size_t>(mesh.lod_count(), mesh_lod::max_lods); lod++)
     {
-      ObjectGeometryMetadata meta = obj->get_geometry_metadata();
-      if (obj->get_render_config().use_indices)
+      count += mesh.lod_indices(lod).size();
+    }
+    return count;
+  }
+
+  uint32_t GeometryPass::select_lod(const Object3D* obj, const glm::mat4& world_mat, const Camera& camera)
+  {
+    uint32_t lod_count = 1;
+    for (const MeshRenderOffsets& mesh_offsets : get_render_offsets(obj))
+    {
+      lod_count = std::max(lod_count, mesh_offsets.lod_count);
+    }
+    uint32_t& lod = m_object_lods[obj];
+    if (lod_count == 1 || camera.get_projection_mode() != Camera::PERSPECTIVE)
+    {
+      lod = 0;
+      return lod;
+    }
+    const BoundingBox& bbox = obj->get_bbox();
+    const glm::vec3 center_world = world_mat * glm::vec4(bbox.center(), 1.f);
+    // world space extents of bbox, so that scale is taken into account
+    const glm::vec3 half_size = (bbox.max() - bbox.min()) * 0.5f;
+    const float radius = glm::length(glm::vec3(world_mat * glm::vec4(half_size, 0.f)));
+    const float distance = glm::length(center_world - camera.get_position());
+    lod = mesh_lod::select_lod(mesh_lod::get_screen_size(radius, distance, camera.get_fov()), lod, lod_count);
+    return lod;
+  }
+
+  void GeometryPass::free_object(const Object3D* obj)
+  {
+    auto obj_it = m_object_geometry.find(obj);
+    if (obj_it == m_object_geometry.end())
+    {
+      return;
+    }
+    const GeometryKey key = obj_it->second;
+    m_object_geometry.erase(obj_it);
+    m_object_lods.erase(obj);
+    auto it = m_allocations.find(key);
+    GeometryAllocation& alloc = it->second;
+    if (--alloc.users > 0)
+    {
+      return;
+    }
+    FreeListAllocator& vertex_heap = alloc.use_indices ? m_vbo_indices_heap : m_vbo_arrays_heap;
+    vertex_heap.free(alloc.vertices.offset, alloc.vertices.count);
+    m_ebo_heap.free(alloc.indices.offset, alloc.indices.count);
+    m_allocations.erase(it);
+    m_render_offsets.erase(key);
+  }
+
+  void GeometryPass::update_render_offsets(const GeometryKey& key)
+  {
+    const GeometryAllocation& alloc = m_allocations.at(key);
+    const std::vector<Mesh>& meshes = *key.meshes;
+    std::vector<MeshRenderOffsets>& meshes_offsets = m_render_offsets[key];
+    // keep material data of existing entries
+    meshes_offsets.resize(meshes.size());
+    size_t vertex_offset = alloc.vertices.offset;
+    size_t index_offset = alloc.indices.offset;
+    for (size_t i = 0; i < meshes_offsets.size(); i++)
+    {
+      const Mesh& mesh = meshes[i];
+      MeshRenderOffsets& mesh_offsets = meshes_offsets[i];
+      if (alloc.use_indices)
       {
-        assert(obj->get_render_config().mode == GL_TRIANGLES);
-        vcount_vbo_indices += meta.vert_count_total;
-        idx_count += meta.face_count_total * 3;
+        mesh_offsets.vbo_indices_offset = vertex_offset * get_vertex_size();
+        mesh_offsets.basev = vertex_offset;
+        mesh_offsets.lod_count = static_cast<uint32_t>(std::min<size_t>(mesh.lod_count(), mesh_lod::max_lods));
+        for (uint32_t lod = 0; lod < mesh_offsets.lod_count; lod++)
+        {
+          const size_t count = mesh.lod_indices(lod).size();
+          mesh_offsets.lods[lod] = { index_offset * sizeof(GLuint), static_cast<GLuint>(count) };
+          index_offset += count;
+        }
       }
       else
       {
-        vcount_vbo_arrays += meta.vert_count_total;
+        // index offset (not in bytes)
+        mesh_offsets.vbo_arrays_offset = vertex_offset;
+      }
+      vertex_offset += mesh.vertices().size();
+    }
+  }
+
+  bool GeometryPass::compact_heap(FreeListAllocator& heap, OpenGLBuffer& buffer, size_t unit_size, bool use_indices, HeapBlock GeometryAllocation::* block_ptr)
+  {
+    if (!heap.has_holes())
+    {
+      return false;
+    }
+    // move the last block of heap into first hole that fits it
+    const size_t allocated_end = heap.allocated_end();
+    auto it = std::find_if(m_allocations.begin(), m_allocations.end(), [&](const auto& item) {
+      const HeapBlock& block = item.second.*block_ptr;
+      return item.second.use_indices == use_indices && block.count > 0 && block.offset + block.count == allocated_end;
+    });
+    if (it == m_allocations.end())
+    {
+      return false;
+    }
+    HeapBlock& block = it->second.*block_ptr;
+    std::optional<size_t> new_offset = heap.allocate(block.count);
+    if (!new_offset.has_value())
+    {
+      return false;
+    }
+    if (*new_offset > block.offset)
+    {
+      // no hole before the block is big enough
+      heap.free(*new_offset, block.count);
+      return false;
+    }
+    buffer.copy_data(block.offset * unit_size, *new_offset * unit_size, block.count * unit_size);
+    heap.free(block.offset, block.count);
+    block.offset = *new_offset;
+    update_render_offsets(it->first);
+    return true;
+  }
+
+  void GeometryPass::compact_heaps(int max_moves)
+  {
+    for (int i = 0; i < max_moves; i++)
+    {
+      bool moved = compact_heap(m_vbo_indices_heap, m_vbo_indices, get_vertex_size(), true, &GeometryAllocation::vertices);
+      moved |= compact_heap(m_vbo_arrays_heap, m_vbo_arrays, get_vertex_size(), false, &GeometryAllocation::vertices);
+      moved |= compact_heap(m_ebo_heap, m_ebo, sizeof(GLuint), true, &GeometryAllocation::indices);
+      if (!moved)
+      {
+        break;
       }
     }
-    m_vbo_arrays.bind();
-    m_vbo_arrays.resize_if_smaller(vcount_vbo_arrays * sizeof(Vertex));
-    m_vbo_arrays.unbind();
-    m_vbo_indices.bind();
-    m_vbo_indices.resize_if_smaller(vcount_vbo_indices * sizeof(Vertex));
-    m_vbo_indices.unbind();
-    m_ebo.bind();
-    m_ebo.resize_if_smaller(idx_count * sizeof(GLuint));
-    m_ebo.unbind();
   }
 
   void GeometryPass::split_objects()
@@ -157,135 +427,597 @@ namespace fury
     }
   }
 
-  void GeometryPass::render_scene()
+  void GeometryPass::render_scene(bool deferred)
   {
+    SceneInfo* scene_info_component = m_scene->get_ui().get_component<SceneInfo>("SceneInfo");
+    if (scene_info_component->is_packed_vertices_enabled() != m_packed_vertices)
+    {
+      set_packed_vertices(!m_packed_vertices);
+    }
     Camera& camera = m_scene->get_camera();
-    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::DEFAULT);
+    Shader* shader = &ShaderStorage::get(deferred ? ShaderStorage::ShaderType::GBUFFER : ShaderStorage::ShaderType::DEFAULT);
     shader->bind();
-    shader->set_vec3("viewPos", camera.get_position());
-    shader->set_int("numLights", m_scene->get_active_lights().size());
-    // bind shadow map. LAST because all others are used in loop below
-    const int shadow_map_slot = static_cast<int>(TextureType::LAST);
-    shader->set_int("shadowMap", shadow_map_slot);
-    glActiveTexture(GL_TEXTURE0 + shadow_map_slot);
-    glBindTexture(GL_TEXTURE_2D, m_shadow_map_texture);
+    m_view_pos_uniform.set(camera.get_position());
+    m_num_lights_uniform.set(static_cast<int>(m_lights_data.size()));
+    m_packed_vertices_uniform.set(m_packed_vertices ? 1 : 0);
+    m_gbuffer_packed_vertices_uniform.set(m_packed_vertices ? 1 : 0);
+    if (!m_lights_data.empty())
+    {
+      const size_t lights_size = m_lights_data.size() * sizeof(LightDescription);
+      RingBuffer::Allocation lights_alloc = m_lights_ring.push(m_lights_data.data(), lights_size);
+      m_lights_ring.bind_range(2, lights_alloc.offset, lights_size);
+      update_light_clusters(camera);
+    }
+    // samplers have fixed bindings in shader, so only textures have to be bound
+    glActiveTexture(GL_TEXTURE0 + shadow_map_texture_slot);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_shadow_maps);
+    if (!m_texture_table.empty())
+    {
+      glBindTextures(0, static_cast<GLsizei>(m_texture_table.size()), m_texture_table.data());
+    }
 
-    SceneInfo* scene_info_component = m_scene->get_ui().get_component<SceneInfo>("SceneInfo");
     Frustum fr;
-    uint32_t num_culled_objects = 0;
+    const Frustum* pfr = nullptr;
     if (scene_info_component->is_frustum_culling_enabled())
     {
       fr = m_scene->get_camera().get_frustum();
+      pfr = &fr;
     }
 
-    for (int i = 0; i < 2; i++)
+    const bool indirect = scene_info_component->is_indirect_rendering_enabled();
+    const bool gpu_culling = indirect && scene_info_component->is_gpu_culling_enabled();
+    m_lods_enabled = scene_info_component->is_lod_enabled();
+    // with gpu culling batched draws are culled by compute shader and CPU doesn't touch their bounds.
+    // the few direct draws aren't culled then
+    // gpu culling tests each command against bounds of its first draw record, so instances are not merged then
+    const uint32_t num_culled_objects = build_draw_commands(gpu_culling ? nullptr : pfr, &camera, indirect ? BatchPolicy::BATCHABLE : BatchPolicy::NONE, !gpu_culling);
+    upload_draw_data();
+    uint32_t draw_calls = gpu_culling ? submit_gpu_culled_commands(pfr) : submit_indirect_commands();
+    draw_calls += render_direct_draws(false);
+    scene_info_component->set_num_culled_objects(gpu_culling ? m_gpu_culled_count : num_culled_objects);
+    // without batching each draw record is a separate draw call
+    scene_info_component->set_draw_calls(draw_calls, static_cast<uint32_t>(m_draw_data.size()));
+    const RenderQueue::Stats& queue_stats = m_render_queue.get_stats();
+    scene_info_component->set_state_changes(queue_stats.state_changes, queue_stats.state_changes_unsorted);
+    shader->unbind();
+  }
+
+  bool GeometryPass::is_batchable(const Object3D* obj, const MeshRenderOffsets& offsets)
+  {
+    // selected objects write to stencil buffer
+    if (obj->is_selected() && obj->has_surface())
     {
-      const Object3D** ppobj = nullptr;
-      size_t size = 0;
-      if (i == 0)
-      {
-        if (m_objects_indices_rendering_mode.empty())
-          continue;
-        m_vao_indices.bind();
-        size = m_objects_indices_rendering_mode.size();
-        ppobj = m_objects_indices_rendering_mode.data();
-      }
-      else
-      {
-        if (m_objects_arrays_rendering_mode.empty())
-          continue;
-        m_vao_arrays.bind();
-        size = m_objects_arrays_rendering_mode.size();
-        ppobj = m_objects_arrays_rendering_mode.data();
-      }
+      return false;
+    }
+    return !offsets.has_overflow_textures;
+  }
 
-      for (size_t obj_i = 0; obj_i < size; obj_i++)
+  void GeometryPass::build_material_table()
+  {
+    m_materials.clear();
+    m_texture_table.clear();
+    std::unordered_map<std::string, GLuint> material_indices;
+    std::unordered_map<GLuint, GLint> texture_slots;
+    // combination of mesh textures, used for draws sorting. 0 is reserved for meshes without textures
+    std::map<std::array<GLuint, static_cast<int>(TextureType::LAST)>, uint32_t> texture_sets = { { {}, 0 } };
+    bool overflow_reported = false;
+    for (auto& [key, meshes_offsets] : m_render_offsets)
+    {
+      for (size_t mesh_i = 0; mesh_i < meshes_offsets.size(); mesh_i++)
       {
-        const Object3D* obj = ppobj[obj_i];
-        auto node = SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id());
-
-        if (scene_info_component->is_frustum_culling_enabled())
+        const Mesh& mesh = (*key.meshes)[mesh_i];
+        MeshRenderOffsets& mesh_offsets = meshes_offsets[mesh_i];
+        const Material& mat = mesh.material();
+        MaterialData material_data;
+        material_data.ambient = glm::vec4(mat.ambient, 0.f);
+        material_data.diffuse = glm::vec4(mat.diffuse, 0.f);
+        material_data.specular = glm::vec4(mat.specular, 0.f);
+        material_data.shininess = mat.shininess;
+        material_data.alpha = mat.alpha;
+
+        // try to put all mesh textures into the table, otherwise mesh uses overflow slots
+        std::array<GLuint, static_cast<int>(TextureType::LAST)> textures = {};
+        size_t new_textures = 0;
+        for (int i = 0; i < static_cast<int>(TextureType::LAST); i++)
+        {
+          if (auto tex = mesh.get_texture(static_cast<TextureType>(i)))
+          {
+            textures[i] = tex->id();
+            new_textures += !texture_slots.contains(textures[i]);
+          }
+        }
+        mesh_offsets.texture_set = texture_sets.try_emplace(textures, static_cast<uint32_t>(texture_sets.size())).first->second;
+        mesh_offsets.has_overflow_textures = m_texture_table.size() + new_textures > texture_table_size;
+        for (int i = 0; i < static_cast<int>(TextureType::LAST); i++)
         {
-          const glm::mat4& transform = node->get_world_mat();
-          BoundingBox bbox = obj->get_bbox();
-          const glm::vec3& min = bbox.min();
-          const glm::vec3& max = bbox.max();
-          const glm::vec3 center = bbox.center();
-          const glm::vec3 extents = (max - min) * 0.5f;
-          const glm::mat3 mm = { glm::abs(transform[0]), glm::abs(transform[1]), glm::abs(transform[2]) };
-          const glm::vec3 center_world = transform * glm::vec4(center, 1);
-          const glm::vec3 extents_world = mm * extents;
-          // approximated AABB if transform has rotation
-          bbox.init(center_world - extents_world, center_world + extents_world);
-          if (!fr.is_inside(bbox))
+          if (textures[i] == 0)
+          {
+            continue;
+          }
+          if (mesh_offsets.has_overflow_textures)
           {
-            num_culled_objects++;
+            material_data.textures[i] = overflow_texture_slot + i;
             continue;
           }
+          auto [it, inserted] = texture_slots.try_emplace(textures[i], static_cast<GLint>(m_texture_table.size()));
+          if (inserted)
+          {
+            m_texture_table.push_back(textures[i]);
+          }
+          material_data.textures[i] = it->second;
         }
-        
-        shader->set_matrix4f("modelMatrix", node->get_world_mat());
-        shader->set_bool("applyShading", obj->shading_mode() != Object3D::ShadingMode::NO_SHADING);
-
-        if (obj->is_selected() && obj->has_surface())
+        if (mesh_offsets.has_overflow_textures && !overflow_reported)
         {
-          // enable writing to the stencil buffer and disable it in the end of current iteration
-          glStencilFunc(GL_ALWAYS, 1, 0xFF);
-          glStencilMask(0xFF);
+          Logger::warn("Texture table is full ({} textures), remaining textured meshes are rendered without batching.", texture_table_size);
+          overflow_reported = true;
         }
 
-        const auto& render_config = obj->get_render_config();
-        const size_t mesh_count = obj->mesh_count();
-        const std::vector<MeshRenderOffsets>& meshes_offsets = m_render_offsets.at(obj);
+        const std::string key(reinterpret_cast<const char*>(&material_data), sizeof(MaterialData));
+        auto [it, inserted] = material_indices.try_emplace(key, static_cast<GLuint>(m_materials.size()));
+        if (inserted)
+        {
+          m_materials.push_back(material_data);
+        }
+        mesh_offsets.material_index = it->second;
+      }
+    }
+    if (m_materials.empty())
+    {
+      return;
+    }
+    m_materials_ssbo.bind();
+    m_materials_ssbo.resize_if_smaller(m_materials.size() * sizeof(MaterialData));
+    m_materials_ssbo.set_data(m_materials.data(), m_materials.size() * sizeof(MaterialData), 0);
+    m_materials_ssbo.set_binding_point(4);
+    m_materials_ssbo.unbind();
+  }
 
-        for (size_t mesh_i = 0; mesh_i < mesh_count; mesh_i++)
+  uint32_t GeometryPass::build_draw_commands(const Frustum* frustum, const Camera* camera, BatchPolicy policy, bool instancing,
+    const std::function<bool(const Object3D*)>& filter)
+  {
+    FURY_PROFILE_SCOPE("GeometryPass::build_draw_commands");
+    for (auto& [mode, commands] : m_elements_commands)
+    {
+      commands.clear();
+    }
+    for (auto& [mode, commands] : m_arrays_commands)
+    {
+      commands.clear();
+    }
+    m_direct_draws.clear();
+    m_draw_data.clear();
+    m_draw_bounds.clear();
+    m_queued_draws.clear();
+    m_render_queue.clear();
+    m_instance_group_indices.clear();
+    m_instance_groups.clear();
+    m_visible_instances.clear();
+    uint32_t num_culled_objects = 0;
+    for (const auto* objects : { &m_objects_indices_rendering_mode, &m_objects_arrays_rendering_mode })
+    {
+      for (const Object3D* obj : *objects)
+      {
+        if (filter && !filter(obj))
+        {
+          continue;
+        }
+        const glm::mat4& world_mat = SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id())->get_world_mat();
+        if (frustum && !::is_visible(*frustum, obj, world_mat))
+        {
+          num_culled_objects++;
+          continue;
+        }
+        uint32_t depth = 0;
+        if (camera)
+        {
+          const glm::vec3 center_world = world_mat * glm::vec4(obj->get_bbox().center(), 1.f);
+          const float view_depth = glm::dot(center_world - camera->get_position(), camera->get_target());
+          depth = RenderQueue::quantize_depth(view_depth, camera->get_znear(), camera->get_zfar());
+        }
+        uint32_t lod = 0;
+        if (camera && m_lods_enabled)
+        {
+          lod = select_lod(obj, world_mat, *camera);
+        }
+        else if (!camera)
+        {
+          // shadow casters use level chosen for main camera
+          auto lod_it = m_object_lods.find(obj);
+          lod = lod_it != m_object_lods.end() ? lod_it->second : 0;
+        }
+        else
+        {
+          m_object_lods[obj] = 0;
+        }
+        // selected objects write to stencil, so they are drawn on their own
+        const bool solo = !instancing || (obj->is_selected() && obj->has_surface());
+        const InstanceGroupKey group_key = { m_object_geometry.at(obj), static_cast<int>(obj->get_render_config().mode), lod, solo ? obj : nullptr };
+        auto [it, inserted] = m_instance_group_indices.try_emplace(group_key, static_cast<uint32_t>(m_instance_groups.size()));
+        if (inserted)
         {
-          const MeshRenderOffsets& mesh_offsets = meshes_offsets[mesh_i];
-          const Mesh& mesh = obj->get_mesh(mesh_i);
+          m_instance_groups.emplace_back().lod = lod;
+        }
+        InstanceGroup& group = m_instance_groups[it->second];
+        group.instance_count++;
+        group.depth = std::min(group.depth, depth);
+        m_visible_instances.push_back({ obj, &world_mat, it->second });
+      }
+    }
+    // make instances of each group contiguous
+    for (uint32_t first = 0; InstanceGroup& group : m_instance_groups)
+    {
+      group.first_instance = first;
+      first += group.instance_count;
+      group.instance_count = 0;
+    }
+    m_instances.resize(m_visible_instances.size());
+    for (const Instance& instance : m_visible_instances)
+    {
+      InstanceGroup& group = m_instance_groups[instance.group];
+      m_instances[group.first_instance + group.instance_count++] = instance;
+    }
 
-          const static std::array texture_uniform_names = { "ambientTex", "diffuseTex", "specularTex" };
-          const static std::array texture_uniform_bools = { "hasAmbientTex", "hasDiffuseTex", "hasSpecularTex" };
-          for (int i = 0; i < static_cast<int>(TextureType::LAST); i++)
-          {
-            if (auto tex = mesh.get_texture(static_cast<TextureType>(i)))
-            {
-              shader->set_bool(texture_uniform_bools[i], true);
-              shader->set_int(texture_uniform_names[i], i);
-              glActiveTexture(GL_TEXTURE0 + i);
-              glBindTexture(GL_TEXTURE_2D, tex->id());
-            }
-            else
-            {
-              shader->set_bool(texture_uniform_bools[i], false);
-            }
-          }
+    for (uint32_t group_idx = 0; group_idx < m_instance_groups.size(); group_idx++)
+    {
+      const InstanceGroup& group = m_instance_groups[group_idx];
+      // instances differ only in draw data, so first one represents whole group
+      const Object3D* obj = m_instances[group.first_instance].obj;
+      const auto& render_config = obj->get_render_config();
+      // vao and primitive mode split batches, so they go right after bucket
+      const uint32_t state = (render_config.use_indices ? 0u : 1u) << 4 | (static_cast<uint32_t>(render_config.mode) & 0xF);
+      const std::vector<MeshRenderOffsets>& meshes_offsets = get_render_offsets(obj);
+      for (size_t mesh_i = 0; mesh_i < meshes_offsets.size(); mesh_i++)
+      {
+        const MeshRenderOffsets& mesh_offsets = meshes_offsets[mesh_i];
+        const bool batch = policy == BatchPolicy::ALL || (policy == BatchPolicy::BATCHABLE && is_batchable(obj, mesh_offsets));
+        const uint64_t key = RenderQueue::make_key(batch ? 0 : 1, state, mesh_offsets.texture_set, mesh_offsets.material_index, group.depth);
+        m_render_queue.push(key, static_cast<uint32_t>(m_queued_draws.size()));
+        m_queued_draws.push_back({ group_idx, mesh_i, batch });
+      }
+    }
+    m_render_queue.sort();
 
-          // set mesh material
-          const auto& mat = mesh.material();
-          shader->set_vec3("material.ambient", mat.ambient);
-          shader->set_vec3("material.diffuse", mat.diffuse);
-          shader->set_vec3("material.specular", mat.specular);
-          shader->set_float("material.shininess", mat.shininess);
-          shader->set_float("material.alpha", mat.alpha);
+    for (const RenderQueue::Item& item : m_render_queue.items())
+    {
+      const QueuedDraw& queued = m_queued_draws[item.payload];
+      const InstanceGroup& group = m_instance_groups[queued.group];
+      const Object3D* obj = m_instances[group.first_instance].obj;
+      const Mesh& mesh = obj->get_mesh(queued.mesh_idx);
+      const MeshRenderOffsets& mesh_offsets = get_render_offsets(obj)[queued.mesh_idx];
+      const auto& render_config = obj->get_render_config();
+      // meshes may have fewer levels than object
+      const uint32_t lod = std::min(group.lod, mesh_offsets.lod_count - 1);
+      // base instance is used as index into draw data buffer, instances of the draw follow it
+      const GLuint draw_idx = static_cast<GLuint>(m_draw_data.size());
+      for (uint32_t i = 0; i < group.instance_count; i++)
+      {
+        const Instance& instance = m_instances[group.first_instance + i];
+        DrawData& draw_data = m_draw_data.emplace_back();
+        draw_data.model_matrix = *instance.world_mat;
+        draw_data.material_index = mesh_offsets.material_index;
+        draw_data.position_offset = glm::vec4(mesh_offsets.position_offset, 0.f);
+        draw_data.position_scale = glm::vec4(mesh_offsets.position_scale, 1.f);
+        draw_data.apply_shading = instance.obj->shading_mode() != Object3D::ShadingMode::NO_SHADING;
+        draw_data.color = glm::packUnorm4x8(instance.obj->color());
+        draw_data.object_id = instance.obj->get_id();
+        const BoundingBox& bbox = instance.obj->get_bbox();
+        m_draw_bounds.push_back({ glm::vec4(bbox.min(), 1.f), glm::vec4(bbox.max(), 1.f) });
+      }
 
-          if (render_config.use_indices)
-          {
-            glDrawElementsBaseVertex(render_config.mode, mesh.faces_as_indices().size(), GL_UNSIGNED_INT, (void*)mesh_offsets.ebo_offset, mesh_offsets.basev);
-          }
-          else
+      if (!queued.batch)
+      {
+        m_direct_draws.push_back({ obj, queued.mesh_idx, draw_idx, group.instance_count, lod });
+      }
+      else if (render_config.use_indices)
+      {
+        DrawElementsIndirectCommand& cmd = m_elements_commands[render_config.mode].emplace_back();
+        cmd.count = mesh_offsets.lods[lod].count;
+        cmd.instance_count = group.instance_count;
+        cmd.first_index = static_cast<GLuint>(mesh_offsets.lods[lod].ebo_offset / sizeof(GLuint));
+        cmd.base_vertex = static_cast<GLint>(mesh_offsets.basev);
+        cmd.base_instance = draw_idx;
+      }
+      else
+      {
+        DrawArraysIndirectCommand& cmd = m_arrays_commands[render_config.mode].emplace_back();
+        cmd.count = static_cast<GLuint>(mesh.vertices().size());
+        cmd.instance_count = group.instance_count;
+        cmd.first = static_cast<GLuint>(mesh_offsets.vbo_arrays_offset);
+        cmd.base_instance = draw_idx;
+      }
+    }
+    return num_culled_objects;
+  }
+
+  void GeometryPass::upload_draw_data()
+  {
+    if (m_draw_data.empty())
+    {
+      return;
+    }
+    const size_t draw_data_size = m_draw_data.size() * sizeof(DrawData);
+    RingBuffer::Allocation draw_data_alloc = m_draw_data_ring.push(m_draw_data.data(), draw_data_size);
+    m_draw_data_ring.bind_range(3, draw_data_alloc.offset, draw_data_size);
+  }
+
+  uint32_t GeometryPass::submit_indirect_commands()
+  {
+    // elements commands go first, then arrays commands. both grouped by primitive mode
+    size_t total_bytes = 0;
+    for (const auto& [mode, commands] : m_elements_commands)
+    {
+      total_bytes += commands.size() * sizeof(DrawElementsIndirectCommand);
+    }
+    for (const auto& [mode, commands] : m_arrays_commands)
+    {
+      total_bytes += commands.size() * sizeof(DrawArraysIndirectCommand);
+    }
+    if (total_bytes == 0)
+    {
+      return 0;
+    }
+    // single allocation for all commands, ring may be recreated on allocation and invalidate previous ones
+    RingBuffer::Allocation commands_alloc = m_indirect_ring.allocate(total_bytes, sizeof(DrawElementsIndirectCommand));
+    std::byte* commands_ptr = static_cast<std::byte*>(commands_alloc.ptr);
+    BindGuard bg(m_indirect_ring);
+
+    uint32_t draw_calls = 0;
+    size_t offset = commands_alloc.offset;
+    {
+      BindGuard bg_vao(m_vao_indices);
+      for (const auto& [mode, commands] : m_elements_commands)
+      {
+        if (commands.empty())
+          continue;
+        std::memcpy(commands_ptr, commands.data(), commands.size() * sizeof(DrawElementsIndirectCommand));
+        commands_ptr += commands.size() * sizeof(DrawElementsIndirectCommand);
+        glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset), static_cast<GLsizei>(commands.size()), 0);
+        offset += commands.size() * sizeof(DrawElementsIndirectCommand);
+        draw_calls++;
+      }
+    }
+    {
+      BindGuard bg_vao(m_vao_arrays);
+      for (const auto& [mode, commands] : m_arrays_commands)
+      {
+        if (commands.empty())
+          continue;
+        std::memcpy(commands_ptr, commands.data(), commands.size() * sizeof(DrawArraysIndirectCommand));
+        commands_ptr += commands.size() * sizeof(DrawArraysIndirectCommand);
+        glMultiDrawArraysIndirect(mode, reinterpret_cast<const void*>(offset), static_cast<GLsizei>(commands.size()), 0);
+        offset += commands.size() * sizeof(DrawArraysIndirectCommand);
+        draw_calls++;
+      }
+    }
+    return draw_calls;
+  }
+
+  uint32_t GeometryPass::submit_gpu_culled_commands(const Frustum* frustum)
+  {
+    // commands of one primitive mode and vao
+    struct CullGroup
+    {
+      GLenum mode = 0;
+      bool use_indices = false;
+      const void* commands = nullptr;
+      GLuint count = 0;
+      // command size in uints
+      GLuint words = 0;
+    };
+    std::vector<CullGroup> groups;
+    size_t total_words = 0;
+    for (const auto& [mode, commands] : m_elements_commands)
+    {
+      if (commands.empty())
+        continue;
+      groups.push_back({ static_cast<GLenum>(mode), true, commands.data(), static_cast<GLuint>(commands.size()), sizeof(DrawElementsIndirectCommand) / sizeof(GLuint) });
+      total_words += groups.back().count * groups.back().words;
+    }
+    for (const auto& [mode, commands] : m_arrays_commands)
+    {
+      if (commands.empty())
+        continue;
+      groups.push_back({ static_cast<GLenum>(mode), false, commands.data(), static_cast<GLuint>(commands.size()), sizeof(DrawArraysIndirectCommand) / sizeof(GLuint) });
+      total_words += groups.back().count * groups.back().words;
+    }
+    read_gpu_culled_count();
+    if (groups.empty())
+    {
+      return 0;
+    }
+    const size_t total_bytes = total_words * sizeof(GLuint);
+
+    RingBuffer::Allocation input_alloc = m_cull_input_ring.allocate(total_bytes);
+    std::byte* input_ptr = static_cast<std::byte*>(input_alloc.ptr);
+    for (const CullGroup& group : groups)
+    {
+      std::memcpy(input_ptr, group.commands, group.count * group.words * sizeof(GLuint));
+      input_ptr += group.count * group.words * sizeof(GLuint);
+    }
+    m_cull_input_ring.bind_range(6, input_alloc.offset, total_bytes);
+    const size_t bounds_size = m_draw_bounds.size() * sizeof(DrawBounds);
+    RingBuffer::Allocation bounds_alloc = m_draw_bounds_ring.push(m_draw_bounds.data(), bounds_size);
+    m_draw_bounds_ring.bind_range(5, bounds_alloc.offset, bounds_size);
+
+    CullData cull_data;
+    if (frustum)
+    {
+      const std::array planes = { &frustum->near, &frustum->far, &frustum->left, &frustum->right, &frustum->top, &frustum->bottom };
+      for (size_t i = 0; i < planes.size(); i++)
+      {
+        cull_data.frustum_planes[i] = glm::vec4(planes[i]->normal, planes[i]->distance);
+      }
+    }
+    else
+    {
+      // every point is inside
+      std::fill(std::begin(cull_data.frustum_planes), std::end(cull_data.frustum_planes), glm::vec4(0.f, 0.f, 0.f, 1.f));
+    }
+    if (m_hiz.is_valid())
+    {
+      cull_data.hiz_view_proj = m_hiz.get_view_proj();
+      cull_data.hiz_size = glm::vec2(m_hiz.width(), m_hiz.height());
+      cull_data.hiz_levels = m_hiz.levels();
+      cull_data.use_occlusion = 1;
+    }
+    RingBuffer::Allocation cull_data_alloc = m_cull_data_ring.push(&cull_data, sizeof(CullData));
+    m_cull_data_ring.bind_range(1, cull_data_alloc.offset, sizeof(CullData));
+
+    // survivors are compacted to the beginning of group range. rest of range stays zeroed,
+    // so group can be drawn with max count as well
+    m_culled_commands.bind();
+    m_culled_commands.resize_if_smaller(total_bytes);
+    glClearBufferSubData(GL_DRAW_INDIRECT_BUFFER, GL_R32UI, 0, total_bytes, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    m_culled_commands.unbind();
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, m_culled_commands.id());
+    // culled count goes first, then visible count of each group
+    const size_t counters_size = (groups.size() + 1) * sizeof(GLuint);
+    m_cull_counters.bind();
+    m_cull_counters.resize_if_smaller(counters_size);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, counters_size, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    m_cull_counters.set_binding_point(8);
+    m_cull_counters.unbind();
+
+    // draws below go with the program that was bound by caller
+    GLint draw_program = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &draw_program);
+    Shader& shader = ShaderStorage::get(ShaderStorage::ShaderType::CULLING);
+    shader.bind();
+    m_hiz.bind();
+    size_t offset_words = 0;
+    for (GLuint group_idx = 0; const CullGroup& group : groups)
+    {
+      m_cull_commands_count_uniform.set(group.count);
+      m_cull_command_words_uniform.set(group.words);
+      m_cull_input_offset_uniform.set(static_cast<unsigned int>(offset_words));
+      m_cull_output_offset_uniform.set(static_cast<unsigned int>(offset_words));
+      m_cull_group_uniform.set(group_idx++);
+      glDispatchCompute((group.count + 63) / 64, 1, 1);
+      offset_words += group.count * group.words;
+    }
+    m_hiz.unbind();
+    glUseProgram(draw_program);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    // culled count is read back few frames later, when fence of this frame is signaled
+    RingBuffer::Allocation readback_alloc = m_cull_readback_ring.allocate(sizeof(GLuint), sizeof(GLuint));
+    glBindBuffer(GL_COPY_READ_BUFFER, m_cull_counters.id());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_cull_readback_ring.id());
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, readback_alloc.offset, sizeof(GLuint));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_cull_readbacks[RingBuffer::get_frame_slot()] = std::make_pair(m_cull_readback_ring.get_generation(), readback_alloc.offset);
+
+    // draw count is taken from counters if supported (GL 4.6), otherwise zeroed commands after survivors draw nothing
+    const bool has_draw_count = glMultiDrawElementsIndirectCount != nullptr && glMultiDrawArraysIndirectCount != nullptr;
+    BindGuard bg(m_culled_commands);
+    if (has_draw_count)
+    {
+      glBindBuffer(GL_PARAMETER_BUFFER, m_cull_counters.id());
+    }
+    uint32_t draw_calls = 0;
+    size_t offset = 0;
+    for (GLuint group_idx = 0; const CullGroup& group : groups)
+    {
+      const void* indirect = reinterpret_cast<const void*>(offset);
+      const GLintptr draw_count_offset = (group_idx + 1) * sizeof(GLuint);
+      BindGuard bg_vao(group.use_indices ? &m_vao_indices : &m_vao_arrays);
+      if (group.use_indices && has_draw_count)
+      {
+        glMultiDrawElementsIndirectCount(group.mode, GL_UNSIGNED_INT, indirect, draw_count_offset, group.count, 0);
+      }
+      else if (group.use_indices)
+      {
+        glMultiDrawElementsIndirect(group.mode, GL_UNSIGNED_INT, indirect, group.count, 0);
+      }
+      else if (has_draw_count)
+      {
+        glMultiDrawArraysIndirectCount(group.mode, indirect, draw_count_offset, group.count, 0);
+      }
+      else
+      {
+        glMultiDrawArraysIndirect(group.mode, indirect, group.count, 0);
+      }
+      offset += group.count * group.words * sizeof(GLuint);
+      group_idx++;
+      draw_calls++;
+    }
+    if (has_draw_count)
+    {
+      glBindBuffer(GL_PARAMETER_BUFFER, 0);
+    }
+    return draw_calls;
+  }
+
+  uint32_t GeometryPass::read_gpu_culled_count()
+  {
+    // frame slot is reused only after its fence is waited, so value copied to it is ready
+    auto& readback = m_cull_readbacks[RingBuffer::get_frame_slot()];
+    if (readback && readback->first == m_cull_readback_ring.get_generation())
+    {
+      m_gpu_culled_count = *static_cast<const GLuint*>(m_cull_readback_ring.get_mapped(readback->second));
+    }
+    readback.reset();
+    return m_gpu_culled_count;
+  }
+
+  uint32_t GeometryPass::render_direct_draws(bool depth_only)
+  {
+    const VertexArrayObject* bound_vao = nullptr;
+    for (const DirectDraw& draw : m_direct_draws)
+    {
+      const Object3D* obj = draw.obj;
+      const auto& render_config = obj->get_render_config();
+      const VertexArrayObject* vao = render_config.use_indices ? &m_vao_indices : &m_vao_arrays;
+      if (vao != bound_vao)
+      {
+        vao->bind();
+        bound_vao = vao;
+      }
+      const MeshRenderOffsets& mesh_offsets = get_render_offsets(obj)[draw.mesh_idx];
+      const Mesh& mesh = obj->get_mesh(draw.mesh_idx);
+      const bool write_stencil = !depth_only && obj->is_selected() && obj->has_surface();
+      if (write_stencil)
+      {
+        glStencilFunc(GL_ALWAYS, 1, 0xFF);
+        glStencilMask(0xFF);
+      }
+      if (!depth_only && mesh_offsets.has_overflow_textures)
+      {
+        // material of this mesh points to overflow slots
+        for (int i = 0; i < static_cast<int>(TextureType::LAST); i++)
+        {
+          if (auto tex = mesh.get_texture(static_cast<TextureType>(i)))
           {
-            glDrawArrays(render_config.mode, static_cast<GLint>(mesh_offsets.vbo_arrays_offset), static_cast<GLsizei>(mesh.vertices().size()));
+            glActiveTexture(GL_TEXTURE0 + overflow_texture_slot + i);
+            glBindTexture(GL_TEXTURE_2D, tex->id());
           }
-          // disable stencil buffer writing
-          glStencilFunc(GL_ALWAYS, 0, 0xFF);
-          glStencilMask(0x00);
         }
       }
+
+      if (render_config.use_indices)
+      {
+        const IndexRange& range = mesh_offsets.lods[draw.lod];
+        glDrawElementsInstancedBaseVertexBaseInstance(render_config.mode, static_cast<GLsizei>(range.count), GL_UNSIGNED_INT,
+          (void*)range.ebo_offset, draw.instance_count, static_cast<GLint>(mesh_offsets.basev), draw.draw_idx);
+      }
+      else
+      {
+        glDrawArraysInstancedBaseInstance(render_config.mode, static_cast<GLint>(mesh_offsets.vbo_arrays_offset),
+          static_cast<GLsizei>(mesh.vertices().size()), draw.instance_count, draw.draw_idx);
+      }
+      if (write_stencil)
+      {
+        // disable stencil buffer writing
+        glStencilFunc(GL_ALWAYS, 0, 0xFF);
+        glStencilMask(0x00);
+      }
     }
-    scene_info_component->set_num_culled_objects(num_culled_objects);
-    m_vao_indices.unbind();
-    m_vao_arrays.unbind();
-    shader->unbind();
+    if (bound_vao)
+    {
+      bound_vao->unbind();
+    }
+    return static_cast<uint32_t>(m_direct_draws.size());
   }
 
   void GeometryPass::render_selected_objects()
@@ -310,18 +1042,20 @@ namespace fury
         selected_world_mat = glm::translate(selected_world_mat, node->get_translation());
         selected_world_mat = glm::scale(selected_world_mat, node->get_scale() + 0.05f);
         selected_world_mat = selected_world_mat * glm::toMat4(node->get_rotation());
-        shader->set_matrix4f("modelMatrix", selected_world_mat);
         const auto& render_config = obj->get_render_config();
         const size_t mesh_count = obj->mesh_count();
-        const std::vector<MeshRenderOffsets>& meshes_offsets = m_render_offsets.at(obj);
+        const std::vector<MeshRenderOffsets>& meshes_offsets = get_render_offsets(obj);
         for (size_t i = 0; i < mesh_count; i++)
         {
           const MeshRenderOffsets& mesh_offsets = meshes_offsets[i];
           const Mesh& mesh = obj->get_mesh(i);
+          // outline shader reads only positions, so their dequantization goes into model matrix
+          const glm::mat4 dequantize = glm::scale(glm::translate(glm::mat4(1.f), mesh_offsets.position_offset), mesh_offsets.position_scale);
+          m_outline_model_matrix_uniform.set(selected_world_mat * dequantize);
           if (render_config.use_indices)
           {
             BindGuard bg(m_vao_indices);
-            glDrawElementsBaseVertex(render_config.mode, mesh.faces_as_indices().size(), GL_UNSIGNED_INT, (void*)mesh_offsets.ebo_offset, mesh_offsets.basev);
+            glDrawElementsBaseVertex(render_config.mode, mesh.faces_as_indices().size(), GL_UNSIGNED_INT, (void*)mesh_offsets.lods[0].ebo_offset, mesh_offsets.basev);
           }
           else
           {
@@ -338,499 +1072,866 @@ namespace fury
   }
 
   void GeometryPass::update()
+  {
+    FURY_PROFILE_SCOPE("GeometryPass::update");
+    // reconcile heaps with scene drawables, so that only added, removed or resized objects are touched
+    std::set<const Object3D*> drawables;
+    for (const auto& obj : m_scene->get_drawables())
+    {
+      drawables.insert(obj.get());
+    }
+    // removed objects and objects that switched to other mesh storage
+    for (auto it = m_object_geometry.begin(); it != m_object_geometry.end();)
+    {
+      const auto [obj, key] = *(it++);
+      if (!drawables.contains(obj) || key != get_geometry_key(obj))
+      {
+        free_object(obj);
+      }
+    }
+    // resized geometry is uploaded again for all its objects
+    std::vector<const Object3D*> resized;
+    for (const auto& [obj, key] : m_object_geometry)
+    {
+      size_t vertex_count = 0;
+      size_t index_count = 0;
+      for (const Mesh& mesh : *key.meshes)
+      {
+        vertex_count += mesh.vertices().size();
+        index_count += key.use_indices ? get_index_count(mesh) : 0;
+      }
+      const GeometryAllocation& alloc = m_allocations.at(key);
+      if (alloc.vertices.count != vertex_count || alloc.indices.count != index_count || m_render_offsets.at(key).size() != key.meshes->size())
+      {
+        resized.push_back(obj);
+      }
+    }
+    for (const Object3D* obj : resized)
+    {
+      free_object(obj);
+    }
+    for (const Object3D* obj : drawables)
+    {
+      if (!m_object_geometry.contains(obj))
+      {
+        upload_object(obj);
+      }
+    }
+    split_objects();
+    update_lights_data();
+    build_material_table();
+  }
+
+  void GeometryPass::tick(float)
   {
     if (m_scene->get_drawables().empty())
     {
-      // clear struct in case if all objects from scene have been deleted, 
-      // because shadow map pass uses same structs for it's pass
-      m_render_offsets.clear();
-      m_objects_arrays_rendering_mode.clear();
-      m_objects_indices_rendering_mode.clear();
       return;
     }
+    for (SceneNode* node : SceneGraphManager::get_dirty_nodes())
+    {
+      // if im light
+      bool lights_need_update = false;
+      if (node->get_owner()->get_dynamic_type_id() == Light::get_static_type_id())
+      {
+        Light* light = static_cast<Light*>(node->get_owner());
+        if (light->is_enabled())
+        {
+          //Logger::info("Dirty light type {}", light->get_description().type);
+          TransformationSceneNode* transform_node = static_cast<TransformationSceneNode*>(node);
+          light->get_description().position = glm::vec4(transform_node->get_world_mat()[3]);
+          glm::vec3 dir = -glm::normalize(glm::vec3(transform_node->get_world_mat()[2]));
+          light->get_description().dir = glm::vec4(dir, 0);
+          //Logger::info("Updating lights data. New pos {}, new dir {}", light->get_description().position, light->get_description().dir);
+          lights_need_update = true;
+        }
+      }
+      if (lights_need_update)
+      {
+        update_lights_data();
+      }
+    }
+    compact_heaps(max_compaction_moves_per_frame);
+    // deferred path draws through DeferredGeometryPass and LightingPass
+    if (m_scene->is_deferred_shading_enabled())
+    {
+      return;
+    }
+    render_scene();
+    render_selected_objects();
+    build_hiz();
+  }
 
-    allocate_memory_for_buffers();
-    split_objects();
-    update_lights_data();
-    m_render_offsets.clear();
+  void GeometryPass::build_hiz()
+  {
+    SceneInfo* scene_info_component = m_scene->get_ui().get_component<SceneInfo>("SceneInfo");
+    if (scene_info_component->is_indirect_rendering_enabled() && scene_info_component->is_gpu_culling_enabled())
+    {
+      const Camera& camera = m_scene->get_camera();
+      m_hiz.build(camera.get_projection_matrix() * camera.get_view_matrix());
+    }
+  }
 
-    size_t vbo_indices_offset = 0;
-    size_t vbo_arrays_offset = 0;
-    size_t ebo_offset = 0;
-    size_t basev = 0;
+  DeferredGeometryPass::DeferredGeometryPass(Scene* scene, GeometryPass* gp) : RenderPass(scene)
+  {
+    m_gp = gp;
+    glGenFramebuffers(1, &m_fbo.id);
+  }
 
-    for (const auto& obj : m_scene->get_drawables())
+  DeferredGeometryPass::~DeferredGeometryPass()
+  {
+    destroy();
+    glDeleteFramebuffers(1, &m_fbo.id);
+  }
+
+  void DeferredGeometryPass::destroy()
+  {
+    for (auto& texture : m_textures)
+    {
+      glDeleteTextures(1, &texture.id);
+      texture.id = 0;
+    }
+  }
+
+  void DeferredGeometryPass::recreate(int w, int h)
+  {
+    destroy();
+    m_width = w;
+    m_height = h;
+    // normals are octahedral encoded, material colors are rgba8 packed into uints
+    constexpr GLenum formats[ATTACHMENT_COUNT] = { GL_RGBA8, GL_RG16_SNORM, GL_RGBA32UI, GL_DEPTH24_STENCIL8 };
+    for (int i = 0; i < ATTACHMENT_COUNT; i++)
+    {
+      glGenTextures(1, &m_textures[i].id);
+      glBindTexture(GL_TEXTURE_2D, m_textures[i]);
+      glTexStorage2D(GL_TEXTURE_2D, 1, formats[i], w, h);
+      // lighting pass reads texels with texelFetch
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    for (int i = ALBEDO; i < DEPTH; i++)
+    {
+      glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, m_textures[i], 0);
+    }
+    // same format as scene framebuffers, so depth and stencil can be blitted to them
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_textures[DEPTH], 0);
+    constexpr GLenum draw_buffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+    glDrawBuffers(3, draw_buffers);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+      Logger::error("DeferredGeometryPass: g-buffer framebuffer is not complete.");
+    }
+  }
+
+  void DeferredGeometryPass::tick(float)
+  {
+    if (!m_scene->is_deferred_shading_enabled() || m_scene->get_drawables().empty())
+    {
+      return;
+    }
+    GLint draw_fbo = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_fbo);
+    const glm::vec2 screen_size = m_scene->get_camera().get_screen_size();
+    const int w = static_cast<int>(screen_size.x);
+    const int h = static_cast<int>(screen_size.y);
+    if (w != m_width || h != m_height)
     {
-      const size_t mesh_count = obj->mesh_count();
-      const auto& render_config = obj->get_render_config();
-      size_t model_vertices_within_indices = 0;
-      std::vector<MeshRenderOffsets>& meshes_offsets = m_render_offsets[obj.get()];
-      for (size_t i = 0; i < mesh_count; i++)
-      {
-        MeshRenderOffsets& mesh_offsets = meshes_offsets.emplace_back();
-        const Mesh& mesh = obj->get_mesh(i);
-        const size_t vsize = mesh.vertices().size() * sizeof(Vertex);
-        const size_t idx_size = mesh.faces_as_indices().size() * sizeof(GLuint);
-        if (render_config.use_indices)
-        {
-          BindChainFIFO bc({ &m_vao_indices, &m_vbo_indices, &m_ebo });
-          m_vbo_indices.set_data(mesh.vertices().data(), vsize, vbo_indices_offset);
-          m_ebo.set_data(mesh.faces_as_indices().data(), idx_size, ebo_offset);
-          mesh_offsets.vbo_indices_offset = vbo_indices_offset;
-          mesh_offsets.ebo_offset = ebo_offset;
-          mesh_offsets.basev = basev;
-          basev += mesh.vertices().size();
-          vbo_indices_offset += vsize;
-          ebo_offset += idx_size;
-        }
-        else
-        {
-          BindChainFIFO bc({ &m_vao_arrays, &m_vbo_arrays });
-          m_vbo_arrays.set_data(mesh.vertices().data(), vsize, vbo_arrays_offset);
-          // index offset (not in bytes)
-          mesh_offsets.vbo_arrays_offset = vbo_arrays_offset / sizeof(Vertex);
-          vbo_arrays_offset += vsize;
-        }
-      }
+      recreate(w, h);
     }
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    const GLfloat zero[4] = {};
+    const GLuint zero_ui[4] = {};
+    glClearBufferfv(GL_COLOR, ALBEDO, zero);
+    glClearBufferfv(GL_COLOR, NORMAL, zero);
+    glClearBufferuiv(GL_COLOR, MATERIAL, zero_ui);
+    glStencilMask(0xFF);
+    glClearBufferfi(GL_DEPTH_STENCIL, 0, 1.f, 0);
+    // albedo alpha is shading flag, not coverage
+    glDisable(GL_BLEND);
+    m_gp->render_scene(true);
+    glEnable(GL_BLEND);
+    glBindFramebuffer(GL_FRAMEBUFFER, draw_fbo);
   }
 
-  void GeometryPass::tick(float)
+  LightingPass::LightingPass(Scene* scene, DeferredGeometryPass* gbuffer, GeometryPass* gp) : RenderPass(scene)
   {
-    if (m_scene->get_drawables().empty())
+    m_gbuffer = gbuffer;
+    m_gp = gp;
+    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::DEFERRED_LIGHTING);
+    m_view_pos_uniform = UniformHandle<glm::vec3>(shader, "viewPos");
+    m_num_lights_uniform = UniformHandle<int>(shader, "numLights");
+    m_num_global_lights_uniform = UniformHandle<int>(shader, "numGlobalLights");
+    m_cluster_params_uniform = UniformHandle<glm::vec4>(shader, "clusterParams");
+    m_inv_view_proj_uniform = UniformHandle<glm::mat4>(shader, "invViewProjMatrix");
+  }
+
+  void LightingPass::tick(float)
+  {
+    if (!m_scene->is_deferred_shading_enabled() || m_scene->get_drawables().empty())
     {
       return;
     }
-    for (SceneNode* node : SceneGraphManager::get_dirty_nodes())
+    const Camera& camera = m_scene->get_camera();
+    Shader& shader = ShaderStorage::get(ShaderStorage::ShaderType::DEFERRED_LIGHTING);
+    // lights and clusters are still bound by g-buffer pass
+    m_view_pos_uniform.set(camera.get_position());
+    m_num_lights_uniform.set(static_cast<int>(m_gp->m_lights_data.size()));
+    m_num_global_lights_uniform.set(static_cast<int>(m_gp->m_light_grid.global_light_count));
+    m_cluster_params_uniform.set(m_gp->m_cluster_params);
+    m_inv_view_proj_uniform.set(glm::inverse(camera.get_projection_matrix() * camera.get_view_matrix()));
+    GLuint textures[DeferredGeometryPass::ATTACHMENT_COUNT];
+    for (int i = 0; i < DeferredGeometryPass::ATTACHMENT_COUNT; i++)
     {
-      // if im light
-      bool lights_need_update = false;
-      if (node->get_owner()->get_dynamic_type_id() == Light::get_static_type_id())
-      {
-        Light* light = static_cast<Light*>(node->get_owner());
-        if (light->is_enabled())
-        {
-          //Logger::info("Dirty light type {}", light->get_description().type);
-          TransformationSceneNode* transform_node = static_cast<TransformationSceneNode*>(node);
-          light->get_description().position = glm::vec4(transform_node->get_world_mat()[3]);
-          glm::vec3 dir = -glm::normalize(glm::vec3(transform_node->get_world_mat()[2]));
-          light->get_description().dir = glm::vec4(dir, 0);
-          //Logger::info("Updating lights data. New pos {}, new dir {}", light->get_description().position, light->get_description().dir);
-          lights_need_update = true;
-        }
-      }
-      if (lights_need_update)
-      {
-        update_lights_data();
-      }
+      textures[i] = m_gbuffer->get_texture(static_cast<DeferredGeometryPass::Attachment>(i));
     }
-    render_scene();
-    render_selected_objects();
+    glBindTextures(0, DeferredGeometryPass::ATTACHMENT_COUNT, textures);
+    glActiveTexture(GL_TEXTURE0 + GeometryPass::shadow_map_texture_slot);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_gp->m_shadow_maps);
+    // skybox is already in color buffer, empty pixels are discarded
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    {
+      BindChainFIFO bchain({ &shader, &m_vao });
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    glDepthMask(GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+
+    // passes drawn after need scene depth, outline of selected objects needs stencil too
+    GLint read_fbo = 0;
+    GLint draw_fbo = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_fbo);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_fbo);
+    const int w = m_gbuffer->width();
+    const int h = m_gbuffer->height();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_gbuffer->get_fbo());
+    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, read_fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_fbo);
+    m_gp->render_selected_objects();
+    m_gp->build_hiz();
   }
 
-  NormalsPass::NormalsPass(Scene* scene) : RenderPass(scene)
+  NormalsPass::NormalsPass(Scene* scene, GeometryPass* gp) : RenderPass(scene)
   {
+    m_gp = gp;
     // TODO: remove listener in dctor
     SceneInfo* scene_info_component = scene->get_ui().get_component<SceneInfo>("SceneInfo");
-    Gizmo* gizmo_component = scene->get_ui().get_component<Gizmo>("Gizmo");
     scene_info_component->on_visible_normals_button_pressed += new InstanceListener(this, &NormalsPass::handle_visible_normals_toggle);
-    global_state::g_on_object_change += new InstanceListener(this, &NormalsPass::handle_object_change);;
-    BindChainFIFO bc({ &m_vao, &m_vbo });
-    ::set_default_vertex_attributes(m_vao);
-    m_model_matrices_ssbo.set_binding_point(1);
+    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::NORMALS);
+    m_packed_vertices_uniform = UniformHandle<int>(shader, "packedVertices");
+    m_draw_offset_uniform = UniformHandle<int>(shader, "drawOffset");
   }
 
   void NormalsPass::update()
   {
-    m_model_matrices.clear();
-    m_voffsets.clear();
-    m_vcounts.clear();
     m_objects_with_visible_normals.clear();
-    m_object_offsets.clear();
-
-    const auto& drawables = m_scene->get_drawables();
-    m_model_matrices.reserve(drawables.size());
-    m_voffsets.reserve(drawables.size());
-    m_vcounts.reserve(drawables.size());
-
-    BindChainFIFO bc({ &m_vao, &m_vbo });
-
-    size_t vbo_size = 0;
-    std::for_each(drawables.begin(), drawables.end(),
-      [&](const std::unique_ptr<Object3D>& obj)
+    for (const auto& obj : m_scene->get_drawables())
+    {
+      if (obj->is_normals_visible())
       {
-        vbo_size += obj->is_normals_visible() * obj->get_geometry_metadata().vert_count_total * sizeof(Vertex);
-      });
-    m_vbo.resize_if_smaller(vbo_size);
+        m_objects_with_visible_normals.insert(obj.get());
+      }
+    }
+  }
 
-    size_t vbo_offset = 0;
-    size_t idx = 0;
-    for (const auto& obj : drawables)
+  GLsizei NormalsPass::build_draws(bool use_indices)
+  {
+    const size_t first_draw = m_draw_data.size();
+    for (const Object3D* obj : m_objects_with_visible_normals)
     {
-      if (!obj->is_normals_visible())
+      auto it = m_gp->m_object_geometry.find(obj);
+      // geometry pass hasn't uploaded object yet
+      if (it == m_gp->m_object_geometry.end() || it->second.use_indices != use_indices)
         continue;
-      m_objects_with_visible_normals.insert(obj.get());
-      m_model_matrices.emplace_back(SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id())->get_world_mat());
-      ObjectGeometryMetadata meta = obj->get_geometry_metadata();
-      ObjectRenderOffsets& obj_offsets = m_object_offsets[obj.get()];
-      m_voffsets.push_back(vbo_offset / sizeof(Vertex));
-      m_vcounts.push_back(meta.vert_count_total);
-      obj_offsets.vcount = meta.vert_count_total;
-      obj_offsets.vbo_offset_vtx_count = vbo_offset / sizeof(Vertex);
-      obj_offsets.internal_idx = idx++;
-      for (const MeshGeometryMetadata& mesh_meta : meta.meshes_data)
+      const glm::mat4& world_mat = SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id())->get_world_mat();
+      const std::vector<Mesh>& meshes = *it->second.meshes;
+      // offsets are read every frame, since heaps compaction and vertex format switch move geometry
+      const std::vector<GeometryPass::MeshRenderOffsets>& meshes_offsets = m_gp->m_render_offsets.at(it->second);
+      for (size_t i = 0; i < meshes_offsets.size(); i++)
       {
-        m_vbo.set_data(mesh_meta.vdata, mesh_meta.vert_count * sizeof(Vertex), vbo_offset);
-        vbo_offset += mesh_meta.vert_count * sizeof(Vertex);
+        const GeometryPass::MeshRenderOffsets& offsets = meshes_offsets[i];
+        const size_t vcount = meshes[i].vertices().size();
+        if (vcount == 0)
+          continue;
+        const size_t first_vertex = use_indices ? offsets.basev : offsets.vbo_arrays_offset;
+        m_draw_data.push_back({ world_mat, glm::vec4(offsets.position_offset, 0.f), glm::vec4(offsets.position_scale, 0.f) });
+        m_firsts.push_back(static_cast<GLint>(first_vertex * 2));
+        m_counts.push_back(static_cast<GLsizei>(vcount * 2));
       }
     }
-    m_model_matrices_ssbo.bind();
-    m_model_matrices_ssbo.resize_if_smaller(sizeof(glm::mat4) * m_model_matrices.size());
-    m_model_matrices_ssbo.set_data(m_model_matrices.data(), sizeof(glm::mat4) * m_model_matrices.size(), 0);
-    m_model_matrices_ssbo.unbind();
+    return static_cast<GLsizei>(m_draw_data.size() - first_draw);
   }
 
   void NormalsPass::tick(float)
   {
     if (m_objects_with_visible_normals.empty())
       return;
+    m_draw_data.clear();
+    m_firsts.clear();
+    m_counts.clear();
+    const GLsizei indices_draws = build_draws(true);
+    const GLsizei arrays_draws = build_draws(false);
+    if (m_draw_data.empty())
+      return;
     Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::NORMALS);
     shader->bind();
     shader->set_vec3("normalColor", glm::vec3(0, 1, 1));
+    m_packed_vertices_uniform.set(m_gp->m_packed_vertices ? 1 : 0);
+    const size_t draw_data_size = sizeof(NormalsDrawData) * m_draw_data.size();
+    RingBuffer::Allocation draw_data_alloc = m_draw_data_ring.push(m_draw_data.data(), draw_data_size);
+    m_draw_data_ring.bind_range(1, draw_data_alloc.offset, draw_data_size);
     BindGuard bg(m_vao);
-    glMultiDrawArrays(GL_POINTS, m_voffsets.data(), m_vcounts.data(), static_cast<GLsizei>(m_objects_with_visible_normals.size()));
+    // indexed and non indexed geometry live in different heaps, one multi draw per heap
+    GLsizei draw_offset = 0;
+    for (auto [vbo, draw_count] : { std::pair{ &m_gp->m_vbo_indices, indices_draws }, std::pair{ &m_gp->m_vbo_arrays, arrays_draws } })
+    {
+      if (draw_count == 0)
+        continue;
+      glBindBufferBase(GL_SHADER_STORAGE_BUFFER, vertices_binding, vbo->id());
+      m_draw_offset_uniform.set(draw_offset);
+      glMultiDrawArrays(GL_LINES, m_firsts.data() + draw_offset, m_counts.data() + draw_offset, draw_count);
+      draw_offset += draw_count;
+    }
     shader->unbind();
   }
 
   void NormalsPass::handle_visible_normals_toggle(Object3D* obj, bool is_visible)
   {
-    // if we don't have info about this object yet
-    if (m_object_offsets.count(obj) == 0)
+    if (is_visible)
     {
-      update();
+      m_objects_with_visible_normals.insert(obj);
     }
     else
     {
-      // just add/exclude it from rendering since we already have info about it
-      m_voffsets.clear();
-      m_vcounts.clear();
-      m_model_matrices.clear();
+      m_objects_with_visible_normals.erase(obj);
+    }
+  }
+
+  ShadowsPass::ShadowsPass(Scene* scene, GeometryPass* gp) : RenderPass(scene)
+  {
+    m_gp = gp;
+    m_light_view_proj_uniform = UniformHandle<glm::mat4>(&ShaderStorage::get(ShaderStorage::ShaderType::SHADOW_MAP), "lightViewProjMatrix");
+    for (GLuint* texture : { &m_shadow_maps.id, &m_static_shadow_maps.id })
+    {
+      glGenTextures(1, texture);
+      glBindTexture(GL_TEXTURE_2D_ARRAY, *texture);
+      glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32F, shadow_map_size, shadow_map_size, shadow_cascades::count);
+      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      // anything that is out of depth map is not in shadow
+      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+      const float border_color[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+      glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border_color);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    for (int i = 0; i < shadow_cascades::count; i++)
+    {
+      glGenTextures(1, &m_cascade_views[i].id);
+      glTextureView(m_cascade_views[i], GL_TEXTURE_2D, m_shadow_maps, GL_DEPTH_COMPONENT32F, 0, 1, i, 1);
+    }
+
+    glGenFramebuffers(1, &m_fbo.id);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_shadow_maps, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+      Logger::error("ShadowsPass: shadow map framebuffer is not complete.");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  }
+
+  ShadowsPass::~ShadowsPass()
+  {
+    glDeleteFramebuffers(1, &m_fbo.id);
+    for (auto& view : m_cascade_views)
+    {
+      glDeleteTextures(1, &view.id);
+    }
+    glDeleteTextures(1, &m_shadow_maps.id);
+    glDeleteTextures(1, &m_static_shadow_maps.id);
+  }
 
-      if (is_visible)
+  void ShadowsPass::update()
+  {
+    m_frame++;
+    for (auto it = m_dynamic_casters.begin(); it != m_dynamic_casters.end();)
+    {
+      if (m_frame - it->second.last_move_frame > dynamic_caster_frames)
       {
-        m_objects_with_visible_normals.insert(obj);
+        // object has settled, so it goes back to static cache
+        invalidate_static_cache(&it->second.world_bbox);
+        it = m_dynamic_casters.erase(it);
       }
       else
       {
-        m_objects_with_visible_normals.erase(obj);
-      }
-
-      size_t idx = 0;
-      for (const Object3D* obj : m_objects_with_visible_normals)
-      {
-        ObjectRenderOffsets& obj_info = m_object_offsets[obj];
-        m_voffsets.push_back(obj_info.vbo_offset_vtx_count);
-        m_vcounts.push_back(obj_info.vcount);
-        m_model_matrices.push_back(SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id())->get_world_mat());
-        obj_info.internal_idx = idx++;
+        ++it;
       }
-      m_model_matrices_ssbo.bind();
-      m_model_matrices_ssbo.set_data(m_model_matrices.data(), sizeof(glm::mat4) * m_model_matrices.size(), 0);
-      m_model_matrices_ssbo.unbind();
     }
-  }
+    fit_cascades();
+    const RingBuffer::Allocation cascades_alloc = m_cascades_ring.push(&m_cascades_data, sizeof(CascadesData));
+    m_cascades_ring.bind_range(2, cascades_alloc.offset, sizeof(CascadesData));
+    if (!has_shadows())
+    {
+      return;
+    }
 
-  void NormalsPass::handle_object_change(const ObjectChangeInfo& info)
-  {
-    const Object3D* obj = info.object;
-    // if we have already rendered normals for this object
-    if (m_object_offsets.count(obj) != 0)
+    // currently only create shadows from directional light
+    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::SHADOW_MAP);
+    shader->bind();
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glViewport(0, 0, shadow_map_size, shadow_map_size);
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    for (int i = 0; i < shadow_cascades::count; i++)
     {
-      // if we moved object 
-      if (info.new_transform)
+      const glm::mat4& matrix = m_cascades_data.matrices[i];
+      const Frustum volume = Frustum::from_matrix(matrix);
+      bool has_dynamic_casters = false;
+      for (const auto& [obj, caster] : m_dynamic_casters)
+      {
+        if (volume.is_inside(caster.world_bbox))
+        {
+          has_dynamic_casters = true;
+          break;
+        }
+      }
+      // cascades are stable while camera and light don't move, so usually nothing has to be redrawn
+      const bool render_static = !m_static_cache_valid[i] || m_static_cache_matrices[i] != matrix;
+      if (!render_static && !has_dynamic_casters && !m_had_dynamic_casters[i])
+      {
+        continue;
+      }
+      m_light_view_proj_uniform.set(matrix);
+      if (render_static)
       {
-        // update model matrix
-        ObjectRenderOffsets& offset_info = m_object_offsets.at(obj);
-        m_model_matrices_ssbo.bind();
-        m_model_matrices_ssbo.set_data(glm::value_ptr(info.new_transform->get_world_mat()), sizeof(glm::mat4), offset_info.internal_idx * sizeof(glm::mat4));
-        m_model_matrices_ssbo.unbind();
+        render_casters(m_static_shadow_maps, i, false);
+        m_static_cache_matrices[i] = matrix;
+        m_static_cache_valid[i] = true;
       }
-      // shading mode has changed
-      else if (info.is_shading_mode_change)
+      glCopyImageSubData(m_static_shadow_maps, GL_TEXTURE_2D_ARRAY, 0, 0, 0, i,
+        m_shadow_maps, GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, shadow_map_size, shadow_map_size, 1);
+      if (has_dynamic_casters)
       {
-        update();
+        render_casters(m_shadow_maps, i, true);
       }
+      m_had_dynamic_casters[i] = has_dynamic_casters;
     }
+    glEnable(GL_CULL_FACE);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    shader->unbind();
   }
 
-  ShadowsPass::ShadowsPass(Scene* scene, GeometryPass* gp) : RenderPass(scene)
+  void ShadowsPass::tick(float)
   {
-    m_gp = gp;
   }
 
-  void ShadowsPass::update()
+  void ShadowsPass::fit_cascades()
   {
-    // currently only create shadows from directional light
     const auto dir_lights = m_scene->get_lights(LightType::DIRECTIONAL);
     if (dir_lights.empty())
     {
+      // zero splits disable shadows in shader
+      m_cascades_data = CascadesData();
       return;
     }
     assert(dir_lights.size() == 1);
-    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::SHADOW_MAP);
-    shader->bind();
-    shader->set_matrix4f("lightViewProjMatrix", dir_lights.front()->get_description().shadow_matrix);
-    for (int i = 0; i < 2; i++)
+    const Camera& camera = m_scene->get_camera();
+    const float znear = camera.get_znear();
+    const float zfar = std::min(camera.get_zfar(), shadow_cascades::max_distance);
+    const std::array<float, shadow_cascades::count> splits = shadow_cascades::compute_splits(znear, zfar);
+    const glm::vec3 light_dir = dir_lights.front()->get_description().dir;
+    const BoundingBox& scene_bbox = m_scene->get_bbox();
+    float slice_near = znear;
+    for (int i = 0; i < shadow_cascades::count; i++)
     {
-      const Object3D** ppobj = nullptr;
-      size_t size = 0;
-      if (i == 0)
-      {
-        if (m_gp->m_objects_indices_rendering_mode.empty())
-          continue;
-        m_gp->m_vao_indices.bind();
-        size = m_gp->m_objects_indices_rendering_mode.size();
-        ppobj = m_gp->m_objects_indices_rendering_mode.data();
-      }
-      else
-      {
-        if (m_gp->m_objects_arrays_rendering_mode.empty())
-          continue;
-        m_gp->m_vao_arrays.bind();
-        size = m_gp->m_objects_arrays_rendering_mode.size();
-        ppobj = m_gp->m_objects_arrays_rendering_mode.data();
-      }
-
-      for (size_t obj_i = 0; obj_i < size; obj_i++)
-      {
-        const Object3D* obj = ppobj[obj_i];
-        shader->set_matrix4f("modelMatrix", SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id())->get_world_mat());
+      const auto corners = shadow_cascades::get_slice_corners(camera.get_view_matrix(), camera.get_fov(), camera.get_aspect(), slice_near, splits[i]);
+      m_cascades_data.matrices[i] = shadow_cascades::fit(corners, light_dir, scene_bbox, shadow_map_size);
+      m_cascades_data.splits[i] = splits[i];
+      slice_near = splits[i];
+    }
+  }
 
-        const auto& render_config = obj->get_render_config();
-        const size_t mesh_count = obj->mesh_count();
-        const std::vector<GeometryPass::MeshRenderOffsets>& meshes_offsets = m_gp->m_render_offsets.at(obj);
+  void ShadowsPass::render_casters(GLuint texture, int cascade, bool dynamic)
+  {
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, cascade);
+    if (!dynamic)
+    {
+      glClear(GL_DEPTH_BUFFER_BIT);
+    }
+    const Frustum volume = Frustum::from_matrix(m_cascades_data.matrices[cascade]);
+    // depth only, so with indirect rendering every mesh goes to the batch
+    const bool indirect = m_scene->get_ui().get_component<SceneInfo>("SceneInfo")->is_indirect_rendering_enabled();
+    m_gp->build_draw_commands(&volume, nullptr, indirect ? GeometryPass::BatchPolicy::ALL : GeometryPass::BatchPolicy::NONE, true,
+      [this, dynamic](const Object3D* obj) { return is_dynamic(obj) == dynamic; });
+    m_gp->upload_draw_data();
+    m_gp->submit_indirect_commands();
+    m_gp->render_direct_draws(true);
+  }
 
-        for (size_t mesh_i = 0; mesh_i < mesh_count; mesh_i++)
-        {
-          const GeometryPass::MeshRenderOffsets& mesh_offsets = meshes_offsets[mesh_i];
-          const Mesh& mesh = obj->get_mesh(mesh_i);
-          if (render_config.use_indices)
-          {
-            glDrawElementsBaseVertex(render_config.mode, mesh.faces_as_indices().size(), GL_UNSIGNED_INT, (void*)mesh_offsets.ebo_offset, mesh_offsets.basev);
-          }
-          else
-          {
-            glDrawArrays(render_config.mode, static_cast<GLint>(mesh_offsets.vbo_arrays_offset), static_cast<GLsizei>(mesh.vertices().size()));
-          }
-        }
+  void ShadowsPass::invalidate_static_cache(const BoundingBox* world_bbox)
+  {
+    for (int i = 0; i < shadow_cascades::count; i++)
+    {
+      if (!world_bbox || Frustum::from_matrix(m_static_cache_matrices[i]).is_inside(*world_bbox))
+      {
+        m_static_cache_valid[i] = false;
       }
     }
-    m_gp->m_vao_indices.unbind();
-    m_gp->m_vao_arrays.unbind();
-    shader->unbind();
   }
 
-  void ShadowsPass::tick(float)
+  void ShadowsPass::mark_dynamic(const Object3D* obj, const BoundingBox& old_world_bbox, const BoundingBox& world_bbox)
   {
+    auto [it, inserted] = m_dynamic_casters.try_emplace(obj);
+    if (inserted)
+    {
+      // static cache still has object at its old place
+      invalidate_static_cache(&old_world_bbox);
+    }
+    it->second.last_move_frame = m_frame;
+    it->second.world_bbox = world_bbox;
   }
 
-  DebugPass::DebugPass()
+  void ShadowsPass::forget(const Object3D* obj)
   {
-    Scene& scene = Scene::instance();
+    m_dynamic_casters.erase(obj);
+  }
 
-    global_state::g_on_object_change += new FunctionListener(std::function(
-      [this](const ObjectChangeInfo& info) {
-        if (info.new_transform) {
-          if (info.object->is_bbox_visible()) {
-            // pop existing bbox and push transformed version
-            handle_visible_bbox_toggle(info.object, false);
-            handle_visible_bbox_toggle(info.object, true);
-          }
-          // if scene's bbox is visible
-          if (m_scene_bbox_matrix.has_value()) {
-            handle_scene_visible_bbox_toggle(false);
-            handle_scene_visible_bbox_toggle(true);
-          }
-        }
+  bool ShadowsPass::intersects_cascades(const BoundingBox& world_bbox) const
+  {
+    if (!has_shadows())
+    {
+      return false;
+    }
+    for (const glm::mat4& matrix : m_cascades_data.matrices)
+    {
+      if (Frustum::from_matrix(matrix).is_inside(world_bbox))
+      {
+        return true;
       }
-    ));
+    }
+    return false;
+  }
 
-    // Lines
+  PickingPass::PickingPass(Scene* scene, GeometryPass* gp) : RenderPass(scene)
+  {
+    m_gp = gp;
+    m_view_proj_uniform = UniformHandle<glm::mat4>(&ShaderStorage::get(ShaderStorage::ShaderType::DEPTH_PICKING), "viewProjMatrix");
+    glGenTextures(1, &m_id_texture.id);
+    glBindTexture(GL_TEXTURE_2D, m_id_texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, 1, 1);
+    glGenTextures(1, &m_depth_texture.id);
+    glBindTexture(GL_TEXTURE_2D, m_depth_texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, 1, 1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &m_fbo.id);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_id_texture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depth_texture, 0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
     {
-      BindChainFIFO bc({ &m_vao, &m_vbo });
-      m_vao.link_attrib(0, 3, GL_FLOAT, sizeof(LineVertex), 0);
-      m_vao.link_attrib(1, 4, GL_FLOAT, sizeof(LineVertex), reinterpret_cast<void*>(offsetof(LineVertex, color)));
+      Logger::error("PickingPass: id framebuffer is not complete.");
     }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  }
+
+  PickingPass::~PickingPass()
+  {
+    glDeleteFramebuffers(1, &m_fbo.id);
+    glDeleteTextures(1, &m_id_texture.id);
+    glDeleteTextures(1, &m_depth_texture.id);
+  }
 
-    // AABBs
+  void PickingPass::update()
+  {
+    // frame slot is reused only after its fence is waited, so id read into it is ready
+    auto& readback = m_readbacks[RingBuffer::get_frame_slot()];
+    if (readback && readback->first == m_readback_ring.get_generation())
+    {
+      m_result = *static_cast<const GLuint*>(m_readback_ring.get_mapped(readback->second));
+    }
+    readback.reset();
+    if (!m_pending)
     {
-      SceneInfo* scene_info_component = scene.get_ui().get_component<SceneInfo>("SceneInfo");
-      Gizmo* gizmo_component = scene.get_ui().get_component<Gizmo>("Gizmo");
-      scene_info_component->on_visible_bbox_button_pressed += new InstanceListener(this, &DebugPass::handle_visible_bbox_toggle);
-      scene_info_component->on_show_scene_bbox += new InstanceListener(this, &DebugPass::handle_scene_visible_bbox_toggle);
+      return;
+    }
 
-      m_vao_bbox.bind();
-      m_vbo_bbox.bind();
-      m_vao_bbox.link_attrib(0, 3, GL_FLOAT, 3 * sizeof(float), 0);
-      m_vbo_bbox.resize(sizeof(::unit_cube));
-      m_vbo_bbox.set_data(&::unit_cube, sizeof(::unit_cube), 0);
-      m_ebo_bbox.bind();
-      m_ebo_bbox.resize(sizeof(::cube_lines_indices));
-      m_ebo_bbox.set_data(&::cube_lines_indices, sizeof(::cube_lines_indices), 0);
-      m_vbo_bbox.unbind();
-      m_vbo_instance_bbox.bind();
-      for (int i = 0; i < 4; i++)
-      {
-        m_vao_bbox.link_attrib(i + 1, 4, GL_FLOAT, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * i));
-        glVertexAttribDivisor(i + 1, 1);
-      }
-      m_vao_bbox.unbind();
+    const Camera& camera = m_scene->get_camera();
+    const glm::vec2 screen_size = camera.get_screen_size();
+    // maps the pixel to the whole 1x1 target
+    const glm::mat4 pick_matrix = glm::pickMatrix(glm::vec2(*m_pending) + 0.5f, glm::vec2(1.f), glm::vec4(0.f, 0.f, screen_size));
+    const glm::mat4 view_proj = pick_matrix * camera.get_projection_matrix() * camera.get_view_matrix();
+    const Frustum volume = Frustum::from_matrix(view_proj);
+
+    Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::DEPTH_PICKING);
+    shader->bind();
+    m_view_proj_uniform.set(view_proj);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glViewport(0, 0, 1, 1);
+    glEnable(GL_DEPTH_TEST);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    const GLuint no_object = 0;
+    glClearBufferuiv(GL_COLOR, 0, &no_object);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    // ids don't need materials, so with indirect rendering every mesh goes to the batch
+    const bool indirect = m_scene->get_ui().get_component<SceneInfo>("SceneInfo")->is_indirect_rendering_enabled();
+    // only triangle meshes can be picked, lines and points are too thin to click on
+    m_gp->build_draw_commands(&volume, nullptr, indirect ? GeometryPass::BatchPolicy::ALL : GeometryPass::BatchPolicy::NONE, true,
+      [](const Object3D* obj) { return obj->get_render_config().mode == GL_TRIANGLES; });
+    m_gp->upload_draw_data();
+    m_gp->submit_indirect_commands();
+    m_gp->render_direct_draws(true);
+
+    RingBuffer::Allocation readback_alloc = m_readback_ring.allocate(sizeof(GLuint), sizeof(GLuint));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_readback_ring.id());
+    glReadPixels(0, 0, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, reinterpret_cast<void*>(readback_alloc.offset));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_readbacks[RingBuffer::get_frame_slot()] = std::make_pair(m_readback_ring.get_generation(), readback_alloc.offset);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    shader->unbind();
+    m_pending.reset();
+  }
+
+  void PickingPass::tick(float)
+  {
+  }
+
+  void PickingPass::request(int x, int y)
+  {
+    m_pending = glm::ivec2(x, y);
+  }
 
-      for (const auto& drawable : scene.get_drawables())
+  std::optional<uint32_t> PickingPass::take_result()
+  {
+    return std::exchange(m_result, std::nullopt);
+  }
+
+  DebugPass::DebugPass()
+  {
+    Scene& scene = Scene::instance();
+    global_state::g_on_object_change += new InstanceListener(this, &DebugPass::handle_object_change);
+    scene.on_object_deleted += new InstanceListener(this, &DebugPass::handle_object_deleted);
+    SceneInfo* scene_info_component = scene.get_ui().get_component<SceneInfo>("SceneInfo");
+    scene_info_component->on_visible_bbox_button_pressed += new InstanceListener(this, &DebugPass::handle_visible_bbox_toggle);
+    scene_info_component->on_show_scene_bbox += new InstanceListener(this, &DebugPass::handle_scene_visible_bbox_toggle);
+
+    const debug_primitives::Meshes meshes = debug_primitives::make_meshes();
+    m_mesh_ranges = meshes.ranges;
+    m_vbo_meshes.bind();
+    m_vbo_meshes.resize(meshes.vertices.size() * sizeof(glm::vec3));
+    m_vbo_meshes.set_data(meshes.vertices.data(), meshes.vertices.size() * sizeof(glm::vec3), 0);
+    m_vbo_meshes.unbind();
+    link_attributes(m_vao_boxes, m_vbo_boxes);
+
+    for (const auto& drawable : scene.get_drawables())
+    {
+      if (drawable->is_bbox_visible())
       {
-        if (drawable->is_bbox_visible())
-        {
-          const glm::mat4& model_mat = SceneGraphManager::get_entity_node<TransformationSceneNode>(drawable->get_id())->get_world_mat();
-          add_bbox(drawable->get_bbox(), model_mat);
-          m_objects_with_visible_bboxes.push_back(drawable->get_id());
-        }
+        handle_visible_bbox_toggle(drawable.get(), true);
       }
     }
   }
 
   void DebugPass::update()
   {
-    update_lines_data();
-    update_bbox_data();
+    if (m_dirty_boxes_begin >= m_dirty_boxes_end)
+    {
+      return;
+    }
+    m_vbo_boxes.bind();
+    if (m_vbo_boxes.get_size() < m_boxes.size() * sizeof(Instance))
+    {
+      // content is lost, so everything is uploaded again
+      m_vbo_boxes.resize(m_boxes.size() * 2 * sizeof(Instance));
+      m_dirty_boxes_begin = 0;
+    }
+    m_dirty_boxes_end = std::min(m_dirty_boxes_end, m_boxes.size());
+    if (m_dirty_boxes_begin < m_dirty_boxes_end)
+    {
+      m_vbo_boxes.set_data(m_boxes.data() + m_dirty_boxes_begin, (m_dirty_boxes_end - m_dirty_boxes_begin) * sizeof(Instance),
+        m_dirty_boxes_begin * sizeof(Instance));
+    }
+    m_vbo_boxes.unbind();
+    m_dirty_boxes_begin = m_dirty_boxes_end = 0;
   }
 
   void DebugPass::tick(float)
   {
-    if (!m_lines.empty())
+    update();
+    size_t transient_count = 0;
+    for (const std::vector<Instance>& instances : m_transient)
     {
-      if (m_dirty_lines_data)
-      {
-        update_lines_data();
-      }
-      Shader& shader = ShaderStorage::get(ShaderStorage::ShaderType::SIMPLE_WITH_VCOLOR);
-      BindChainFIFO bc({ &shader, &m_vao });
-      shader.set_matrix4f("modelMatrix", glm::mat4(1.f));
-      glDrawArrays(GL_LINES, 0, m_lines.size());
+      transient_count += instances.size();
     }
-
-    if (!m_bbox_instance_matrices.empty() || m_scene_bbox_matrix.has_value())
+    if (transient_count == 0 && m_boxes.empty())
     {
-      if (m_dirty_bbox_data)
-      {
-        update_bbox_data();
-      }
-      Shader* shader = &ShaderStorage::get(ShaderStorage::ShaderType::BOUNDING_BOX);
-      BindChainFIFO bc({ shader, &m_vao_bbox });
-      shader->set_vec3("color", glm::vec3(0, 1, 0));
-      glDrawElementsInstanced(GL_LINES, 24, GL_UNSIGNED_INT, 0, m_bbox_instance_matrices.size());
-      if (m_scene_bbox_matrix)
-      {
-        glDrawElementsInstancedBaseInstance(GL_LINES, 24, GL_UNSIGNED_INT, 0, 1, m_bbox_instance_matrices.size());
-      }
+      return;
+    }
+    Shader& shader = ShaderStorage::get(ShaderStorage::ShaderType::DEBUG_PRIMITIVES);
+    BindGuard sg(shader);
+    if (!m_boxes.empty())
+    {
+      BindGuard bg(m_vao_boxes);
+      draw_instances(PrimitiveType::BOX, m_boxes.size(), 0);
+    }
+    if (transient_count == 0)
+    {
+      return;
+    }
+    // instance aligned allocation, so each type is drawn from the ring with base instance
+    RingBuffer::Allocation alloc = m_transient_ring.allocate(transient_count * sizeof(Instance), sizeof(Instance));
+    if (m_transient_ring.id() != m_transient_linked_buffer)
+    {
+      // ring storage was recreated, attributes have to point to new buffer
+      link_attributes(m_vao_transient, m_transient_ring);
+      m_transient_linked_buffer = m_transient_ring.id();
     }
+    BindGuard bg(m_vao_transient);
+    Instance* dst = static_cast<Instance*>(alloc.ptr);
+    size_t first_instance = alloc.offset / sizeof(Instance);
+    for (size_t type = 0; type < primitive_types_count; type++)
+    {
+      std::vector<Instance>& instances = m_transient[type];
+      if (instances.empty())
+        continue;
+      std::memcpy(dst, instances.data(), instances.size() * sizeof(Instance));
+      draw_instances(static_cast<PrimitiveType>(type), instances.size(), first_instance);
+      dst += instances.size();
+      first_instance += instances.size();
+      // capacity is kept for next frame
+      instances.clear();
+    }
+  }
+
+  void DebugPass::draw_line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color)
+  {
+    m_transient[static_cast<size_t>(PrimitiveType::LINE)].push_back(debug_primitives::line(a, b, color));
+  }
+
+  void DebugPass::draw_sphere(const glm::vec3& center, float radius, const glm::vec4& color)
+  {
+    m_transient[static_cast<size_t>(PrimitiveType::SPHERE)].push_back(debug_primitives::sphere(center, radius, color));
+  }
+
+  void DebugPass::draw_frustum(const glm::mat4& view_proj, const glm::vec4& color)
+  {
+    m_transient[static_cast<size_t>(PrimitiveType::FRUSTUM)].push_back(debug_primitives::frustum(view_proj, color));
   }
 
-  void DebugPass::add_line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color)
+  void DebugPass::draw_bbox(const BoundingBox& bbox, const glm::mat4& transform, const glm::vec4& color)
   {
-    m_lines.emplace_back(LineVertex{ a, color });
-    m_lines.emplace_back(LineVertex{ b, color });
-    m_dirty_lines_data = true;
+    m_transient[static_cast<size_t>(PrimitiveType::BOX)].push_back(debug_primitives::box(bbox, transform, color));
   }
 
   void DebugPass::clear()
   {
-    m_lines.clear();
-    m_bbox_instance_matrices.clear();
-    m_objects_with_visible_bboxes.clear();
+    for (std::vector<Instance>& instances : m_transient)
+    {
+      instances.clear();
+    }
+    m_boxes.clear();
+    m_dirty_boxes_begin = m_dirty_boxes_end = 0;
   }
 
   void DebugPass::handle_visible_bbox_toggle(Object3D* obj, bool is_visible)
   {
     if (is_visible)
     {
-      m_objects_with_visible_bboxes.push_back(obj->get_id());
       const glm::mat4& model_mat = SceneGraphManager::get_entity_node<TransformationSceneNode>(obj->get_id())->get_world_mat();
-      add_bbox(obj->get_bbox(), model_mat);
+      set_persistent_box(obj->get_id(), obj->get_bbox(), model_mat);
     }
     else
     {
-      int idx = 0;
-      for (uint32_t id : m_objects_with_visible_bboxes)
-      {
-        if (id == obj->get_id())
-          break;
-        idx++;
-      }
-      // Swap item to be removed with last and pop it
-      std::iter_swap(m_objects_with_visible_bboxes.begin() + idx,
-        m_objects_with_visible_bboxes.begin() + (m_objects_with_visible_bboxes.size() - 1));
-      std::iter_swap(m_bbox_instance_matrices.begin() + idx,
-        m_bbox_instance_matrices.begin() + (m_bbox_instance_matrices.size() - 1));
-      m_objects_with_visible_bboxes.pop_back();
-      m_bbox_instance_matrices.pop_back();
-      m_dirty_bbox_data = true;
+      erase_persistent_box(obj->get_id());
     }
   }
 
   void DebugPass::handle_scene_visible_bbox_toggle(bool is_visible)
   {
-    m_dirty_bbox_data = true;
     if (is_visible)
     {
-      add_bbox(Scene::instance().get_bbox(), glm::mat4(1.f));
-      m_scene_bbox_matrix = m_bbox_instance_matrices.back();
-      m_bbox_instance_matrices.pop_back();
+      set_persistent_box(scene_bbox_key, Scene::instance().get_bbox(), glm::mat4(1.f));
     }
     else
     {
-      m_scene_bbox_matrix.reset();
+      erase_persistent_box(scene_bbox_key);
+    }
+  }
+
+  void DebugPass::handle_object_change(const ObjectChangeInfo& info)
+  {
+    if (!info.new_transform)
+    {
+      return;
+    }
+    if (m_boxes.contains(info.object->get_id()))
+    {
+      set_persistent_box(info.object->get_id(), info.object->get_bbox(), info.new_transform->get_world_mat());
+    }
+    if (m_boxes.contains(scene_bbox_key))
+    {
+      set_persistent_box(scene_bbox_key, Scene::instance().get_bbox(), glm::mat4(1.f));
     }
+  }
+
+  void DebugPass::handle_object_deleted(Object3D* obj)
+  {
+    erase_persistent_box(obj->get_id());
+  }
+
+  void DebugPass::set_persistent_box(uint32_t key, const BoundingBox& bbox, const glm::mat4& transform)
+  {
+    mark_box_dirty(m_boxes.insert_or_assign(key, debug_primitives::box(bbox, transform, glm::vec4(0, 1, 0, 1))));
+  }
 
+  void DebugPass::erase_persistent_box(uint32_t key)
+  {
+    // last box moved into the hole
+    if (std::optional<size_t> moved = m_boxes.erase(key))
+    {
+      mark_box_dirty(*moved);
+    }
   }
 
-  void DebugPass::update_bbox_data()
+  void DebugPass::mark_box_dirty(size_t idx)
   {
-    const bool include_scene_bbox = m_scene_bbox_matrix.has_value();
-    m_vbo_instance_bbox.bind();
-    m_vbo_instance_bbox.resize_if_smaller((m_bbox_instance_matrices.size() + include_scene_bbox) * sizeof(glm::mat4));
-    m_vbo_instance_bbox.set_data(m_bbox_instance_matrices.data(), sizeof(glm::mat4) * m_bbox_instance_matrices.size(), 0);
-    if (include_scene_bbox)
+    if (m_dirty_boxes_begin >= m_dirty_boxes_end)
     {
-      m_vbo_instance_bbox.set_data(glm::value_ptr(m_scene_bbox_matrix.value()), sizeof(glm::mat4), sizeof(glm::mat4) * m_bbox_instance_matrices.size());
+      m_dirty_boxes_begin = idx;
+      m_dirty_boxes_end = idx + 1;
+      return;
     }
-    m_vbo_instance_bbox.unbind();
-    m_dirty_bbox_data = false;
+    m_dirty_boxes_begin = std::min(m_dirty_boxes_begin, idx);
+    m_dirty_boxes_end = std::max(m_dirty_boxes_end, idx + 1);
   }
 
-  void DebugPass::update_lines_data()
+  void DebugPass::link_attributes(VertexArrayObject& vao, const OpenGLObject& instances)
   {
-    const size_t buf_size = m_lines.size() * sizeof(LineVertex);
-    BindGuard bg(m_vbo);
-    m_vbo.resize_if_smaller(buf_size);
-    m_vbo.set_data(m_lines.data(), m_lines.size() * sizeof(LineVertex), 0);
-    m_dirty_lines_data = false;
+    BindGuard bg(vao);
+    m_vbo_meshes.bind();
+    vao.link_attrib(0, 3, GL_FLOAT, sizeof(glm::vec3), nullptr);
+    instances.bind();
+    // transform takes 4 locations
+    for (GLuint i = 0; i < 4; i++)
+    {
+      vao.link_attrib(i + 1, 4, GL_FLOAT, sizeof(Instance), reinterpret_cast<void*>(offsetof(Instance, transform) + sizeof(glm::vec4) * i));
+      glVertexAttribDivisor(i + 1, 1);
+    }
+    vao.link_attrib(5, 4, GL_FLOAT, sizeof(Instance), reinterpret_cast<void*>(offsetof(Instance, color)));
+    glVertexAttribDivisor(5, 1);
   }
 
-  void DebugPass::add_bbox(const BoundingBox& bbox, const glm::mat4& transform)
+  void DebugPass::draw_instances(PrimitiveType type, size_t count, size_t first_instance)
   {
-    const glm::vec3& min = bbox.min();
-    const glm::vec3& max = bbox.max();
-    const glm::vec3 center = bbox.center();
-    const glm::vec3 extents = (max - min);
-    const glm::mat3 mm = { glm::abs(transform[0]), glm::abs(transform[1]), glm::abs(transform[2]) };
-    const glm::vec3 center_world = transform * glm::vec4(center, 1);
-    const glm::vec3 extents_world = mm * extents;
-    glm::mat4& out_mat = m_bbox_instance_matrices.emplace_back(1.f);
-    // approximated AABB if transform has rotation
-    out_mat = glm::translate(out_mat, center_world) * glm::scale(out_mat, extents_world);
-    // OBB
-    //out_mat = transform * (glm::translate(out_mat, center) * glm::scale(out_mat, extents));
-    m_dirty_bbox_data = true;
+    const debug_primitives::MeshRange& mesh = m_mesh_ranges[static_cast<size_t>(type)];
+    glDrawArraysInstancedBaseInstance(GL_LINES, mesh.first, mesh.count, static_cast<GLsizei>(count), static_cast<GLuint>(first_instance));
   }
 
   SelectionWheelPass::SelectionWheelPass(Scene* scene, ItemSelectionWheel* wheel) : RenderPass(scene), m_wheel(wheel)
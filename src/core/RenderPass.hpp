@@ -5,13 +5,32 @@
 #include "opengl/VertexBufferObject.hpp"
 #include "opengl/ElementBufferObject.hpp"
 #include "opengl/SSBO.hpp"
+#include "opengl/RingBuffer.hpp"
+#include "opengl/DrawIndirectBuffer.hpp"
+#include "opengl/Texture.hpp"
 #include "Singleton.hpp"
+#include "Shader.hpp"
+#include "RenderQueue.hpp"
+#include "FreeListAllocator.hpp"
+#include "DebugPrimitives.hpp"
+#include "SlotMap.hpp"
+#include "Light.hpp"
+#include "HiZBuffer.hpp"
+#include "ShadowCascades.hpp"
+#include "LightClusters.hpp"
+#include "ge/MeshLod.hpp"
+#include "ge/Vertex.hpp"
 #include "glm/glm.hpp"
 #include "glad/glad.h"
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <optional>
+#include <array>
+#include <functional>
+#include <limits>
+#include <compare>
 
 namespace fury
 {
@@ -20,92 +39,497 @@ namespace fury
   class ItemSelectionWheel;
   struct SelectionWheelSlot;
   class Object3D;
+  class Mesh;
   class BoundingBox;
+  struct Frustum;
+  class Camera;
 
   class RenderPass : public ITickable
   {
   public:
     RenderPass(Scene* scene);
     virtual void update() = 0;
+    // for GPU timings
+    virtual const char* get_name() const = 0;
   protected:
     Scene* m_scene = nullptr;
   };
 
   class GeometryPass : public RenderPass
   {
+    // part of ebo with indices of single level of detail
+    struct IndexRange
+    {
+      size_t ebo_offset = 0;
+      GLuint count = 0;
+    };
     struct MeshRenderOffsets
     {
       size_t vbo_indices_offset = 0;
       // index offset (not in bytes)
       size_t vbo_arrays_offset = 0;
-      size_t ebo_offset = 0;
       size_t basev = 0;
+      // levels of detail share vertices, level 0 is the full mesh
+      std::array<IndexRange, mesh_lod::max_lods> lods;
+      uint32_t lod_count = 1;
+      // packed positions are relative to mesh bounds, position = offset + packed * scale
+      glm::vec3 position_offset = glm::vec3(0.f);
+      glm::vec3 position_scale = glm::vec3(1.f);
+      // index into materials table
+      GLuint material_index = 0;
+      // id of mesh textures combination, 0 if mesh has no textures
+      uint32_t texture_set = 0;
+      // mesh textures didn't fit into texture table and are bound to overflow slots right before the draw
+      bool has_overflow_textures = false;
+    };
+    // layouts are defined by OpenGL spec
+    struct DrawElementsIndirectCommand
+    {
+      GLuint count = 0;
+      GLuint instance_count = 0;
+      GLuint first_index = 0;
+      GLint base_vertex = 0;
+      GLuint base_instance = 0;
+    };
+    struct DrawArraysIndirectCommand
+    {
+      GLuint count = 0;
+      GLuint instance_count = 0;
+      GLuint first = 0;
+      GLuint base_instance = 0;
+    };
+    // match GLSL 430 layout. indexed by gl_BaseInstance in shaders
+    struct DrawData
+    {
+      glm::mat4 model_matrix = glm::mat4(1.f);
+      GLuint material_index = 0;
+      GLuint apply_shading = 0;
+      // object tint as rgba8, multiplied with vertex color
+      GLuint color = 0xFFFFFFFF;
+      // entity id of object, written to id target by picking
+      GLuint object_id = 0;
+      // dequantization of packed vertex positions
+      glm::vec4 position_offset = glm::vec4(0.f);
+      glm::vec4 position_scale = glm::vec4(1.f);
     };
+    struct MaterialData
+    {
+      glm::vec4 ambient;
+      glm::vec4 diffuse;
+      glm::vec4 specular;
+      float shininess = 0.f;
+      float alpha = 0.f;
+      // texture unit of each TextureType or -1 if mesh doesn't have such texture
+      GLint textures[static_cast<int>(TextureType::LAST)] = { -1, -1, -1 };
+      GLint pad[3] = {};
+    };
+    // local space bounds of draw record, indexed by base instance in culling.comp
+    struct DrawBounds
+    {
+      glm::vec4 min;
+      glm::vec4 max;
+    };
+    // match GLSL 140 layout of CullData block in culling.comp
+    struct CullData
+    {
+      glm::vec4 frustum_planes[6];
+      glm::mat4 hiz_view_proj = glm::mat4(1.f);
+      glm::vec2 hiz_size = glm::vec2(0.f);
+      GLint hiz_levels = 0;
+      GLint use_occlusion = 0;
+    };
+    static_assert(sizeof(DrawData) % 16 == 0 && sizeof(MaterialData) % 16 == 0 && sizeof(CullData) % 16 == 0);
+    // draw that goes through glDraw*BaseInstance instead of the batch
+    struct DirectDraw
+    {
+      const Object3D* obj = nullptr;
+      size_t mesh_idx = 0;
+      GLuint draw_idx = 0;
+      GLuint instance_count = 1;
+      uint32_t lod = 0;
+    };
+    // range of heap in heap units (vertices or indices)
+    struct HeapBlock
+    {
+      size_t offset = 0;
+      size_t count = 0;
+    };
+    // objects that share mesh storage share geometry in heaps
+    struct GeometryKey
+    {
+      const std::vector<Mesh>* meshes = nullptr;
+      bool use_indices = false;
+      auto operator<=>(const GeometryKey&) const = default;
+    };
+    // place of all meshes of geometry in vertex and index heaps
+    struct GeometryAllocation
+    {
+      HeapBlock vertices;
+      HeapBlock indices;
+      bool use_indices = false;
+      // number of objects that use this geometry
+      size_t users = 0;
+    };
+    // visible objects that can be drawn with a single instanced draw per mesh
+    struct InstanceGroupKey
+    {
+      GeometryKey geometry;
+      int mode = 0;
+      uint32_t lod = 0;
+      // object that has to be drawn on its own, e.g. selected one
+      const Object3D* solo = nullptr;
+      auto operator<=>(const InstanceGroupKey&) const = default;
+    };
+    // instances of group are contiguous in m_instances
+    struct InstanceGroup
+    {
+      uint32_t first_instance = 0;
+      uint32_t instance_count = 0;
+      uint32_t lod = 0;
+      // of nearest instance
+      uint32_t depth = std::numeric_limits<uint32_t>::max();
+    };
+    struct Instance
+    {
+      const Object3D* obj = nullptr;
+      const glm::mat4* world_mat = nullptr;
+      uint32_t group = 0;
+    };
+    // visible mesh of instance group waiting in render queue
+    struct QueuedDraw
+    {
+      uint32_t group = 0;
+      size_t mesh_idx = 0;
+      bool batch = false;
+    };
+    enum class BatchPolicy
+    {
+      NONE,
+      BATCHABLE,
+      ALL
+    };
+    // texture units layout, must match bindings in default.frag
+    constexpr static int texture_table_size = 12;
+    constexpr static int overflow_texture_slot = texture_table_size;
+    constexpr static int shadow_map_texture_slot = overflow_texture_slot + static_cast<int>(TextureType::LAST);
+    constexpr static int max_compaction_moves_per_frame = 4;
   public:
-    GeometryPass(Scene* scene, int shadow_map_texture);
+    GeometryPass(Scene* scene);
     void update() override;
+    const char* get_name() const override { return "Geometry"; }
     void tick(float) override;
+    // cascaded shadow maps array texture
+    void set_shadow_maps(GLuint texture) { m_shadow_maps = texture; }
   private:
-    void allocate_memory_for_buffers();
+    size_t allocate_from_heap(FreeListAllocator& heap, OpenGLBuffer& buffer, size_t count, size_t unit_size);
+    static GeometryKey get_geometry_key(const Object3D* obj);
+    // indices of all levels of detail
+    static size_t get_index_count(const Mesh& mesh);
+    // level of detail of object for camera, with hysteresis against level it had in previous frame
+    uint32_t select_lod(const Object3D* obj, const glm::mat4& world_mat, const Camera& camera);
+    // uploads object geometry unless it's already uploaded for another object with the same mesh storage
+    void upload_object(const Object3D* obj);
+    // writes mesh vertices to vbo in current vertex format
+    void upload_vertices(const Mesh& mesh, MeshRenderOffsets& mesh_offsets, bool use_indices);
+    // uploads all geometry again in other vertex format
+    void set_packed_vertices(bool packed);
+    size_t get_vertex_size() const { return m_packed_vertices ? sizeof(PackedVertex) : sizeof(Vertex); }
+    // geometry is freed when its last object is freed
+    void free_object(const Object3D* obj);
+    void update_render_offsets(const GeometryKey& key);
+    const std::vector<MeshRenderOffsets>& get_render_offsets(const Object3D* obj) const { return m_render_offsets.at(m_object_geometry.at(obj)); }
+    // moves last block of heap into a hole. returns true if block has been moved
+    bool compact_heap(FreeListAllocator& heap, OpenGLBuffer& buffer, size_t unit_size, bool use_indices, HeapBlock GeometryAllocation::* block_ptr);
+    void compact_heaps(int max_moves);
     void split_objects();
-    void render_scene();
+    // deferred fills g-buffer instead of shading
+    void render_scene(bool deferred = false);
+    void build_material_table();
+    // bins lights into clusters of camera frustum and uploads cluster light lists
+    void update_light_clusters(const Camera& camera);
+    // culls objects and fills draw data and commands in render queue order. camera is used for depth sorting
+    // and selection of levels of detail.
+    // with instancing visible objects that share geometry are drawn by one instanced command per mesh.
+    // objects rejected by filter are skipped and not counted as culled
+    uint32_t build_draw_commands(const Frustum* frustum, const Camera* camera, BatchPolicy policy, bool instancing,
+      const std::function<bool(const Object3D*)>& filter = nullptr);
+    void upload_draw_data();
+    uint32_t submit_indirect_commands();
+    // culls batched commands on GPU against frustum and hi-z of previous frame and draws survivors
+    uint32_t submit_gpu_culled_commands(const Frustum* frustum);
+    // number of draws culled on GPU few frames ago, result is read without waiting
+    uint32_t read_gpu_culled_count();
+    uint32_t render_direct_draws(bool depth_only);
     void render_selected_objects();
+    // occluders for next frame from depth of currently bound framebuffer
+    void build_hiz();
     void on_new_scene_object(Object3D* obj);
     void handle_object_change(const ObjectChangeInfo& info);
     void update_lights_data();
+    // mesh can be put in multi draw indirect batch if it doesn't need per draw state changes
+    static bool is_batchable(const Object3D* obj, const MeshRenderOffsets& offsets);
   private:
     // share all buffers data with shadow pass to avoid same data duplication
     friend class ShadowsPass;
+    friend class DeferredGeometryPass;
+    friend class LightingPass;
+    friend class NormalsPass;
+    friend class PickingPass;
     VertexArrayObject m_vao_indices;
     VertexArrayObject m_vao_arrays;
     VertexBufferObject m_vbo_indices;
     VertexBufferObject m_vbo_arrays;
     ElementBufferObject m_ebo;
-    SSBO m_lights_data_ssbo;
-    std::map<const Object3D*, std::vector<MeshRenderOffsets>> m_render_offsets;
+    RingBuffer m_lights_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    // clusters and their light indices are bound together, separate rings so growth of one doesn't drop binding of other
+    RingBuffer m_light_clusters_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    RingBuffer m_light_indices_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    light_clusters::Grid m_light_grid;
+    // view space cluster bounds and projection they were computed for
+    std::vector<BoundingBox> m_cluster_bounds;
+    glm::mat4 m_cluster_projection = glm::mat4(0.f);
+    // tile size and depth slice scale and bias, lighting shaders find fragment cluster with it
+    glm::vec4 m_cluster_params = glm::vec4(0.f);
+    std::vector<LightDescription> m_lights_data;
+    // persistent heaps over vbos (in vertices) and ebo (in indices)
+    FreeListAllocator m_vbo_indices_heap;
+    FreeListAllocator m_vbo_arrays_heap;
+    FreeListAllocator m_ebo_heap;
+    std::map<GeometryKey, GeometryAllocation> m_allocations;
+    std::map<GeometryKey, std::vector<MeshRenderOffsets>> m_render_offsets;
+    std::map<const Object3D*, GeometryKey> m_object_geometry;
+    // level of detail selected in last camera pass, shadows use it too
+    std::unordered_map<const Object3D*, uint32_t> m_object_lods;
+    bool m_lods_enabled = true;
+    bool m_packed_vertices = false;
     std::vector<const Object3D*> m_objects_indices_rendering_mode;
     std::vector<const Object3D*> m_objects_arrays_rendering_mode;
-    int m_shadow_map_texture;
+    // per draw data. rebuilt each frame from m_render_offsets
+    RingBuffer m_indirect_ring = RingBuffer(GL_DRAW_INDIRECT_BUFFER);
+    RingBuffer m_draw_data_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    // multi draw calls take single primitive mode, so split commands by mode
+    std::map<int, std::vector<DrawElementsIndirectCommand>> m_elements_commands;
+    std::map<int, std::vector<DrawArraysIndirectCommand>> m_arrays_commands;
+    std::vector<DirectDraw> m_direct_draws;
+    std::vector<DrawData> m_draw_data;
+    std::vector<DrawBounds> m_draw_bounds;
+    RenderQueue m_render_queue;
+    std::vector<QueuedDraw> m_queued_draws;
+    std::map<InstanceGroupKey, uint32_t> m_instance_group_indices;
+    std::vector<InstanceGroup> m_instance_groups;
+    std::vector<Instance> m_visible_instances;
+    // visible instances sorted by group
+    std::vector<Instance> m_instances;
+    // deduplicated materials and textures of all meshes. rebuilt in update()
+    SSBO m_materials_ssbo;
+    std::vector<MaterialData> m_materials;
+    std::vector<GLuint> m_texture_table;
+    // gpu culling
+    HiZBuffer m_hiz;
+    RingBuffer m_cull_data_ring = RingBuffer(GL_UNIFORM_BUFFER);
+    RingBuffer m_cull_input_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    RingBuffer m_draw_bounds_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    RingBuffer m_cull_readback_ring = RingBuffer(GL_COPY_WRITE_BUFFER, true);
+    DrawIndirectBuffer m_culled_commands;
+    SSBO m_cull_counters;
+    // where culled count was copied to in each frame slot, as (ring generation, offset)
+    std::array<std::optional<std::pair<uint64_t, size_t>>, RingBuffer::frames_in_flight> m_cull_readbacks;
+    uint32_t m_gpu_culled_count = 0;
+    UniformHandle<unsigned int> m_cull_commands_count_uniform;
+    UniformHandle<unsigned int> m_cull_command_words_uniform;
+    UniformHandle<unsigned int> m_cull_input_offset_uniform;
+    UniformHandle<unsigned int> m_cull_output_offset_uniform;
+    UniformHandle<unsigned int> m_cull_group_uniform;
+    UniformHandle<glm::vec3> m_view_pos_uniform;
+    UniformHandle<int> m_num_lights_uniform;
+    UniformHandle<int> m_packed_vertices_uniform;
+    UniformHandle<int> m_gbuffer_packed_vertices_uniform;
+    UniformHandle<int> m_num_global_lights_uniform;
+    UniformHandle<glm::vec4> m_cluster_params_uniform;
+    UniformHandle<glm::mat4> m_outline_model_matrix_uniform;
+    GLuint m_shadow_maps = 0;
   };
 
+  // Cascaded shadow maps of directional light. Static casters of each cascade are cached in separate texture and
+  // re-rendered only when cascade matrix changes or cache is invalidated. Recently moved objects are dynamic casters,
+  // they are drawn every frame on top of the copy of static cache
   class ShadowsPass : public RenderPass
   {
+    // match GLSL 140 layout of ShadowCascades block in default.frag
+    struct CascadesData
+    {
+      glm::mat4 matrices[shadow_cascades::count] = {};
+      glm::vec4 splits = glm::vec4(0.f);
+    };
+    struct DynamicCaster
+    {
+      uint64_t last_move_frame = 0;
+      BoundingBox world_bbox;
+    };
   public:
+    constexpr static int shadow_map_size = 2048;
+    // object stays dynamic caster for this number of frames after its last move
+    constexpr static uint64_t dynamic_caster_frames = 30;
     ShadowsPass(Scene* scene, GeometryPass* gp);
+    ~ShadowsPass();
+    // renders cascades that have changed, is called once per frame
+    void update() override;
+    const char* get_name() const override { return "Shadows"; }
+    void tick(float) override;
+    // invalidates static cache of cascades that intersect world_bbox or all cascades if it's null
+    void invalidate_static_cache(const BoundingBox* world_bbox = nullptr);
+    // moved object becomes dynamic caster. old_world_bbox is removed from static cache
+    void mark_dynamic(const Object3D* obj, const BoundingBox& old_world_bbox, const BoundingBox& world_bbox);
+    void forget(const Object3D* obj);
+    bool intersects_cascades(const BoundingBox& world_bbox) const;
+    GLuint get_shadow_maps() const { return m_shadow_maps; }
+    // 2D view of single cascade
+    GLuint get_cascade_view(int cascade) const { return m_cascade_views[cascade]; }
+  private:
+    void fit_cascades();
+    void render_casters(GLuint texture, int cascade, bool dynamic);
+    bool is_dynamic(const Object3D* obj) const { return m_dynamic_casters.contains(obj); }
+    // splits are zero without directional light
+    bool has_shadows() const { return m_cascades_data.splits[shadow_cascades::count - 1] > 0.f; }
+  private:
+    GeometryPass* m_gp;
+    UniformHandle<glm::mat4> m_light_view_proj_uniform;
+    OpenGLIdWrapper<GLuint> m_fbo;
+    // depth texture arrays with layer per cascade
+    OpenGLIdWrapper<GLuint> m_shadow_maps;
+    OpenGLIdWrapper<GLuint> m_static_shadow_maps;
+    std::array<OpenGLIdWrapper<GLuint>, shadow_cascades::count> m_cascade_views;
+    RingBuffer m_cascades_ring = RingBuffer(GL_UNIFORM_BUFFER);
+    CascadesData m_cascades_data;
+    // matrices that static cache was rendered with
+    std::array<glm::mat4, shadow_cascades::count> m_static_cache_matrices = {};
+    std::array<bool, shadow_cascades::count> m_static_cache_valid = {};
+    // cascade has to be recomposed if it had dynamic casters in previous frame
+    std::array<bool, shadow_cascades::count> m_had_dynamic_casters = {};
+    std::unordered_map<const Object3D*, DynamicCaster> m_dynamic_casters;
+    uint64_t m_frame = 0;
+  };
+
+  // Renders entity ids of objects under clicked pixel. Camera projection is narrowed to the pixel, so geometry pass
+  // culls everything that doesn't cover it and 1x1 id target is drawn. Id is copied to persistently mapped ring buffer
+  // and read few frames later, when fence of the frame is signaled, so click never stalls the pipeline
+  class PickingPass : public RenderPass
+  {
+  public:
+    PickingPass(Scene* scene, GeometryPass* gp);
+    ~PickingPass();
+    // collects finished readback and renders pending request, is called once per frame
     void update() override;
+    const char* get_name() const override { return "Picking"; }
+    void tick(float) override;
+    // pixel with origin at bottom left of screen. newer request replaces pending one
+    void request(int x, int y);
+    // entity id under pixel of finished request, 0 if there was no object. empty while request is in flight
+    std::optional<uint32_t> take_result();
+  private:
+    GeometryPass* m_gp;
+    UniformHandle<glm::mat4> m_view_proj_uniform;
+    OpenGLIdWrapper<GLuint> m_fbo;
+    OpenGLIdWrapper<GLuint> m_id_texture;
+    OpenGLIdWrapper<GLuint> m_depth_texture;
+    RingBuffer m_readback_ring = RingBuffer(GL_PIXEL_PACK_BUFFER, true);
+    std::optional<glm::ivec2> m_pending;
+    // where id was read to in each frame slot, as (ring generation, offset)
+    std::array<std::optional<std::pair<uint64_t, size_t>>, RingBuffer::frames_in_flight> m_readbacks;
+    std::optional<uint32_t> m_result;
+  };
+
+  // G-buffer of deferred shading. Geometry is drawn by GeometryPass with g-buffer shader, so culling, batching
+  // and levels of detail are shared with forward path
+  class DeferredGeometryPass : public RenderPass
+  {
+  public:
+    // attachments, texture units in deferred_lighting.frag are the same
+    enum Attachment
+    {
+      ALBEDO,
+      NORMAL,
+      MATERIAL,
+      DEPTH,
+      ATTACHMENT_COUNT
+    };
+    DeferredGeometryPass(Scene* scene, GeometryPass* gp);
+    ~DeferredGeometryPass();
+    void update() override {}
+    const char* get_name() const override { return "G-buffer"; }
+    void tick(float) override;
+    GLuint get_fbo() const { return m_fbo; }
+    GLuint get_texture(Attachment attachment) const { return m_textures[attachment]; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+  private:
+    void recreate(int w, int h);
+    void destroy();
+  private:
+    GeometryPass* m_gp;
+    OpenGLIdWrapper<GLuint> m_fbo;
+    std::array<OpenGLIdWrapper<GLuint>, ATTACHMENT_COUNT> m_textures;
+    int m_width = 0;
+    int m_height = 0;
+  };
+
+  // Shades g-buffer in one full screen pass. Light volumes are the clusters of GeometryPass, each pixel iterates
+  // only over lights that reach its cluster
+  class LightingPass : public RenderPass
+  {
+  public:
+    LightingPass(Scene* scene, DeferredGeometryPass* gbuffer, GeometryPass* gp);
+    void update() override {}
+    const char* get_name() const override { return "Deferred lighting"; }
     void tick(float) override;
   private:
+    DeferredGeometryPass* m_gbuffer;
     GeometryPass* m_gp;
+    VertexArrayObject m_vao;
+    UniformHandle<glm::vec3> m_view_pos_uniform;
+    UniformHandle<int> m_num_lights_uniform;
+    UniformHandle<int> m_num_global_lights_uniform;
+    UniformHandle<glm::vec4> m_cluster_params_uniform;
+    UniformHandle<glm::mat4> m_inv_view_proj_uniform;
   };
 
-  // points + geometry shader
+  // line per vertex, vertices are pulled in shader straight from geometry pass heaps
   class NormalsPass : public RenderPass
   {
-    struct ObjectRenderOffsets
+    // per mesh, indexed by draw id. layout must match normals.vert
+    struct NormalsDrawData
     {
-      // vertex count for current model
-      size_t vcount = 0;
-      // offset in vbo (in vertices count)
-      size_t vbo_offset_vtx_count = 0;
-      // object index in m_model_matrices vector
-      size_t internal_idx = 0;
+      glm::mat4 model_matrix = glm::mat4(1.f);
+      // dequantization of packed vertex positions
+      glm::vec4 position_offset = glm::vec4(0.f);
+      glm::vec4 position_scale = glm::vec4(1.f);
     };
+    static_assert(sizeof(NormalsDrawData) % 16 == 0);
+    // shader reads vertices as arrays of uints
+    static_assert(sizeof(Vertex) == 12 * sizeof(GLuint) && sizeof(PackedVertex) == 5 * sizeof(GLuint));
+    constexpr static GLuint vertices_binding = 11;
   public:
-    NormalsPass(Scene* scene);
+    NormalsPass(Scene* scene, GeometryPass* gp);
     void update() override;
+    const char* get_name() const override { return "Normals"; }
     void tick(float) override;
   private:
     void handle_visible_normals_toggle(Object3D* obj, bool is_visible);
-    void handle_object_change(const ObjectChangeInfo& info);
+    // appends draws of meshes from indexed or non indexed vertex heap, returns number of appended draws
+    GLsizei build_draws(bool use_indices);
   private:
+    GeometryPass* m_gp = nullptr;
+    // no attributes, but core profile doesn't draw without bound vao
     VertexArrayObject m_vao;
-    VertexBufferObject m_vbo;
-    SSBO m_model_matrices_ssbo;
+    RingBuffer m_draw_data_ring = RingBuffer(GL_SHADER_STORAGE_BUFFER);
+    UniformHandle<int> m_packed_vertices_uniform;
+    // draw id restarts in every multi draw
+    UniformHandle<int> m_draw_offset_uniform;
     std::set<const Object3D*> m_objects_with_visible_normals;
-    std::vector<glm::mat4> m_model_matrices;
-    std::vector<GLsizei> m_voffsets;
-    std::vector<GLsizei> m_vcounts;
-    std::map<const Object3D*, ObjectRenderOffsets> m_object_offsets;
+    std::vector<NormalsDrawData> m_draw_data;
+    // two vertices per mesh vertex
+    std::vector<GLint> m_firsts;
+    std::vector<GLsizei> m_counts;
   };
 
   class SelectionWheelPass : public RenderPass
@@ -113,6 +537,7 @@ namespace fury
   public:
     SelectionWheelPass(Scene* scene, ItemSelectionWheel* wheel);
     void update() override;
+    const char* get_name() const override { return "Selection wheel"; }
     void tick(float) override;
   private:
     ItemSelectionWheel* m_wheel = nullptr;
@@ -131,19 +556,33 @@ namespace fury
   public:
     InfiniteGridPass(Scene* scene);
     void update() override {}
+    const char* get_name() const override { return "Grid"; }
     void tick(float) override;
   private:
     VertexArrayObject m_vao;
   };
 
-  // TODO: move normals pass here
+  // Persistent bboxes of objects and scene are kept densely in a slot map mirrored to vertex buffer,
+  // so toggles and transform changes update single instance in place. Transient primitives live for one frame,
+  // they are collected during the frame and written to ring buffer in tick.
+  // Every primitive type is drawn with one instanced draw
   class DebugPass : public Singleton<DebugPass>
   {
+    using Instance = debug_primitives::Instance;
+    using PrimitiveType = debug_primitives::Type;
+    constexpr static size_t primitive_types_count = static_cast<size_t>(PrimitiveType::COUNT);
+    // key of scene bbox among persistent boxes, entity ids never reach it
+    constexpr static uint32_t scene_bbox_key = std::numeric_limits<uint32_t>::max();
   public:
+    // uploads changed persistent boxes
     void update();
     void tick(float);
-    void add_line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color = glm::vec4(1, 1, 1, 1));
-    void add_bbox(const BoundingBox& bbox, const glm::mat4& transform);
+    // transient primitives, drawn in current frame only
+    void draw_line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color = glm::vec4(1, 1, 1, 1));
+    void draw_sphere(const glm::vec3& center, float radius, const glm::vec4& color = glm::vec4(1, 1, 1, 1));
+    void draw_frustum(const glm::mat4& view_proj, const glm::vec4& color = glm::vec4(1, 1, 1, 1));
+    void draw_bbox(const BoundingBox& bbox, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1, 1, 1, 1));
+    // drops transient primitives and persistent boxes
     void clear();
   private:
     DebugPass();
@@ -151,28 +590,30 @@ namespace fury
   private:
     void handle_visible_bbox_toggle(Object3D* obj, bool is_visible);
     void handle_scene_visible_bbox_toggle(bool is_visible);
-    void update_bbox_data();
-    void update_lines_data();
+    void handle_object_change(const ObjectChangeInfo& info);
+    void handle_object_deleted(Object3D* obj);
+    void set_persistent_box(uint32_t key, const BoundingBox& bbox, const glm::mat4& transform);
+    void erase_persistent_box(uint32_t key);
+    void mark_box_dirty(size_t idx);
+    void link_attributes(VertexArrayObject& vao, const OpenGLObject& instances);
+    void draw_instances(PrimitiveType type, size_t count, size_t first_instance);
   private:
-    struct LineVertex {
-      glm::vec3 pos;
-      glm::vec4 color;
-    };
-    // Lines
-    VertexArrayObject m_vao;
-    VertexBufferObject m_vbo;
-    std::vector<LineVertex> m_lines;
-    bool m_dirty_lines_data = true;
-    // AABBs
-    std::optional<glm::mat4> m_scene_bbox_matrix;
-    std::vector<uint32_t> m_objects_with_visible_bboxes;
-    std::vector<glm::mat4> m_bbox_instance_matrices;
-    VertexArrayObject m_vao_bbox;
-    VertexBufferObject m_vbo_bbox;
-    VertexBufferObject m_vbo_instance_bbox;
-    ElementBufferObject m_ebo_bbox;
-    bool m_dirty_bbox_data = true;
-    // Normals
+    // unit meshes of all primitive types
+    VertexBufferObject m_vbo_meshes;
+    std::array<debug_primitives::MeshRange, primitive_types_count> m_mesh_ranges;
+    // Transient primitives
+    VertexArrayObject m_vao_transient;
+    RingBuffer m_transient_ring = RingBuffer(GL_ARRAY_BUFFER);
+    // ring buffer that vao attributes point to
+    GLuint m_transient_linked_buffer = 0;
+    std::array<std::vector<Instance>, primitive_types_count> m_transient;
+    // Persistent boxes by entity id
+    SlotMap<uint32_t, Instance> m_boxes;
+    VertexArrayObject m_vao_boxes;
+    VertexBufferObject m_vbo_boxes;
+    // instances changed since last upload
+    size_t m_dirty_boxes_begin = 0;
+    size_t m_dirty_boxes_end = 0;
   };
 
 }
@@ -0,0 +1,93 @@
+#include "RenderQueue.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+  uint64_t pack(uint64_t value, int bits)
+  {
+    return value & ((uint64_t(1) << bits) - 1);
+  }
+}
+
+namespace fury
+{
+  uint64_t RenderQueue::make_key(uint32_t bucket, uint32_t state, uint32_t texture_set, uint32_t material, uint32_t depth)
+  {
+    uint64_t key = ::pack(bucket, bucket_bits);
+    key = (key << state_bits) | ::pack(state, state_bits);
+    key = (key << texture_set_bits) | ::pack(texture_set, texture_set_bits);
+    key = (key << material_bits) | ::pack(material, material_bits);
+    key = (key << depth_bits) | ::pack(depth, depth_bits);
+    return key;
+  }
+
+  uint32_t RenderQueue::quantize_depth(float depth, float znear, float zfar)
+  {
+    if (!(zfar > znear))
+    {
+      return 0;
+    }
+    const float normalized = std::clamp((depth - znear) / (zfar - znear), 0.f, 1.f);
+    constexpr uint32_t max_depth = (1u << depth_bits) - 1;
+    return static_cast<uint32_t>(std::lround(normalized * max_depth));
+  }
+
+  void RenderQueue::clear()
+  {
+    m_items.clear();
+    m_stats = {};
+  }
+
+  void RenderQueue::push(uint64_t key, uint32_t payload)
+  {
+    if (!m_items.empty() && state_part(m_items.back().key) != state_part(key))
+    {
+      m_stats.state_changes_unsorted++;
+    }
+    m_items.push_back({ key, payload });
+    m_stats.items++;
+  }
+
+  void RenderQueue::sort()
+  {
+    m_scratch.resize(m_items.size());
+    // 8 passes of 8 bits. pass is skipped if all keys have same byte on its position
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+      std::array<uint32_t, 256> counts = {};
+      for (const Item& item : m_items)
+      {
+        counts[(item.key >> shift) & 0xFF]++;
+      }
+      if (m_items.empty() || counts[(m_items.front().key >> shift) & 0xFF] == m_items.size())
+      {
+        continue;
+      }
+      uint32_t offset = 0;
+      for (uint32_t& count : counts)
+      {
+        const uint32_t c = count;
+        count = offset;
+        offset += c;
+      }
+      for (const Item& item : m_items)
+      {
+        m_scratch[counts[(item.key >> shift) & 0xFF]++] = item;
+      }
+      m_items.swap(m_scratch);
+    }
+    m_stats.state_changes = count_state_changes();
+  }
+
+  uint32_t RenderQueue::count_state_changes() const
+  {
+    uint32_t changes = 0;
+    for (size_t i = 1; i < m_items.size(); i++)
+    {
+      changes += state_part(m_items[i - 1].key) != state_part(m_items[i].key);
+    }
+    return changes;
+  }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace fury
+{
+  // Draws of a pass sorted by 64-bit key. Key layout from most to least significant bits:
+  // | bucket (4) | pipeline state (8) | texture set (12) | material (16) | view depth (24) |
+  // so that draws are grouped by state first and go front to back within same state.
+  class RenderQueue
+  {
+  public:
+    struct Item
+    {
+      uint64_t key = 0;
+      // index into caller's draw list
+      uint32_t payload = 0;
+    };
+    struct Stats
+    {
+      uint32_t items = 0;
+      // number of times state part of the key changes between neighbour draws
+      uint32_t state_changes = 0;
+      uint32_t state_changes_unsorted = 0;
+    };
+    constexpr static int depth_bits = 24;
+    constexpr static int material_bits = 16;
+    constexpr static int texture_set_bits = 12;
+    constexpr static int state_bits = 8;
+    constexpr static int bucket_bits = 4;
+    static uint64_t make_key(uint32_t bucket, uint32_t state, uint32_t texture_set, uint32_t material, uint32_t depth);
+    // map view space depth from [znear, zfar] to depth bits of the key
+    static uint32_t quantize_depth(float depth, float znear, float zfar);
+    void clear();
+    void push(uint64_t key, uint32_t payload);
+    // stable LSD radix sort by key
+    void sort();
+    const std::vector<Item>& items() const { return m_items; }
+    const Stats& get_stats() const { return m_stats; }
+  private:
+    static uint64_t state_part(uint64_t key) { return key >> depth_bits; }
+    uint32_t count_state_changes() const;
+  private:
+    std::vector<Item> m_items;
+    std::vector<Item> m_scratch;
+    Stats m_stats;
+  };
+}
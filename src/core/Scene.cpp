@@ -8,7 +8,6 @@
 #include "Camera.hpp"
 #include "ShaderStorage.hpp"
 #include "BindGuard.hpp"
-#include "PipelineBufferManager.hpp"
 #include "Logger.hpp"
 #include "ge/Cube.hpp"
 #include "ge/Icosahedron.hpp"
@@ -26,6 +25,11 @@
 #include "SceneGraphManager.hpp"
 #include "ObjectChangeInfo.hpp"
 #include "Globals.hpp"
+#include "GpuTimers.hpp"
+#include "Profiler.hpp"
+#include "ModelLoader.hpp"
+#include "opengl/Texture2D.hpp"
+#include "opengl/UploadStats.hpp"
 
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -39,14 +43,13 @@
 
 #include <cassert>
 #include <fstream>
-
-#define DEBUG_RAY 0
-
-constexpr int SHADOWMAP_WIDTH = 2048;
-constexpr int SHADOWMAP_HEIGHT = 2048;
+#include <algorithm>
+#include <array>
 
 namespace
 {
+  // relative to working directory
+  const std::filesystem::path PROFILER_TRACE_FILE = "fury_trace.json";
   const std::filesystem::path SKYBOX_TEXTURES_FOLDER = fury::AssetManager::get_assets_folder() / "textures" / "skybox";
   // clang-format off
   std::array<std::filesystem::path, 6> skybox_faces =
@@ -80,6 +83,21 @@ namespace
   };
   // clang-format on
   constexpr std::array shadow_map_data = init_shadow_map_data();
+
+  // vertices of the object color were recolored by it, others came with mesh
+  void reset_baked_vertex_color(fury::Object3D& obj)
+  {
+    for (fury::Mesh& mesh : obj.get_meshes())
+    {
+      for (fury::Vertex& vertex : mesh.vertices())
+      {
+        if (vertex.color == obj.color())
+        {
+          vertex.color = glm::vec4(1.f);
+        }
+      }
+    }
+  }
 } // namespace
 
 namespace fury
@@ -100,6 +118,7 @@ namespace fury
     scene_info_component->on_hide += new InstanceListener(this, &Scene::handle_ui_component_closing);
     scene_info_component->on_polygon_mode_change += new InstanceListener(this, &Scene::change_polygon_mode);
     scene_info_component->msaa_button_click += new InstanceListener(this, &Scene::handle_msaa_button_toggle);
+    scene_info_component->deferred_shading_button_click += new InstanceListener(this, &Scene::handle_deferred_shading_button_toggle);
     on_new_object_added += new FunctionListener(std::function(
         [this](Object3D* obj)
         {
@@ -119,54 +138,9 @@ namespace fury
     input_system.on_mouse_button_clicked += new InstanceListener(this, &Scene::handle_mouse_click);
     m_window->on_window_size_change += new InstanceListener(this, &Scene::handle_window_size_change);
 
-    auto& main_scene_fbo = m_fbos["main"];
-    main_scene_fbo.bind();
-    main_scene_fbo.attach_texture(Texture2D(w, h, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE));
-    RenderBufferCreateInfo info = { w, h };
-    main_scene_fbo.attach_renderbuffer(info);
-    main_scene_fbo.unbind();
-
-    auto& main_ms = m_fbos["mainMS"];
-    main_ms.bind();
-    main_ms.attach_texture_ms(Texture2DMS(w, h, GL_RGB));
-    RenderBufferCreateInfo info2 = { w, h };
-    info2.is_multisampled = true;
-    main_ms.attach_renderbuffer(info2);
-    main_ms.unbind();
-
-    auto& shadows_fbo = m_fbos["shadowMap"];
-    shadows_fbo.bind();
-    shadows_fbo.attach_texture(
-        Texture2D(SHADOWMAP_WIDTH, SHADOWMAP_HEIGHT, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT), false);
-    shadows_fbo.texture()->bind();
-    // anything that is out of depth map is not in shadow
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-    shadows_fbo.texture()->unbind();
-    shadows_fbo.unbind();
-
-    for (const auto& [name, fbo] : m_fbos)
-    {
-      fbo.bind();
-      assert(fbo.is_complete());
-      fbo.unbind();
-    }
-
     m_skybox.set_cubemap(Cubemap(skybox_faces));
-    m_screen_quad.init(main_scene_fbo.texture()->id());
-    m_shadow_map_quad.init(shadow_map_data, shadows_fbo.texture()->id(), true);
     m_fps_limiter.set_limit(glfwGetVideoMode(glfwGetPrimaryMonitor())->refreshRate);
 
-    UniformBuffer& ubo = PipelineUBOManager::get("cameraData");
-    ubo.bind();
-    ubo.resize(sizeof(glm::mat4) * 2);
-    ubo.set_binding_point(0);
-    ubo.unbind();
-
     SelectionWheelConfig cfg;
     cfg.items_count = 6;
     cfg.inner_circle_radius_px = 200;
@@ -184,11 +158,20 @@ namespace fury
       }
     }
 
-    m_render_passes.emplace_back(std::make_unique<GeometryPass>(this, shadows_fbo.texture()->id()));
-    m_render_passes.emplace_back(std::make_unique<NormalsPass>(this));
+    m_render_passes.emplace_back(std::make_unique<GeometryPass>(this));
+    GeometryPass* geometry_pass = static_cast<GeometryPass*>(m_render_passes[0].get());
+    auto deferred_geometry_pass = std::make_unique<DeferredGeometryPass>(this, geometry_pass);
+    auto lighting_pass = std::make_unique<LightingPass>(this, deferred_geometry_pass.get(), geometry_pass);
+    m_render_passes.emplace_back(std::move(deferred_geometry_pass));
+    m_render_passes.emplace_back(std::move(lighting_pass));
+    m_render_passes.emplace_back(std::make_unique<NormalsPass>(this, geometry_pass));
     m_render_passes.emplace_back(std::make_unique<SelectionWheelPass>(this, &m_selection_wheel));
     m_render_passes.emplace_back(std::make_unique<InfiniteGridPass>(this));
-    m_shadows_pass = std::make_unique<ShadowsPass>(this, static_cast<GeometryPass*>(m_render_passes[0].get()));
+    m_shadows_pass = std::make_unique<ShadowsPass>(this, geometry_pass);
+    m_picking_pass = std::make_unique<PickingPass>(this, geometry_pass);
+    geometry_pass->set_shadow_maps(m_shadows_pass->get_shadow_maps());
+    // nearest cascade
+    m_shadow_map_quad.init(shadow_map_data, m_shadows_pass->get_cascade_view(0), true);
 
     // load(AssetManager::get_from_relative("scenes/demo.bin").value().string());
     create_default_scene();
@@ -198,20 +181,29 @@ namespace fury
   {
   }
 
-  void Scene::render()
+  void Scene::render(uint32_t frame_count, FrameBenchmark* benchmark)
   {
     using namespace std::chrono;
     using namespace std::chrono_literals;
-    const auto& main_fbo = m_fbos.at("main");
-    const auto& main_fbo_ms = m_fbos.at("mainMS");
     GLFWwindow* gl_window = m_window->gl_window();
     ImGuiIO& io = ImGui::GetIO();
     steady_clock::time_point prev_frame_time;
     steady_clock::time_point fps_timer = steady_clock::now();
     int frame_count_per_sec = 0;
-    while (!glfwWindowShouldClose(gl_window))
+    const steady_clock::time_point run_start = steady_clock::now();
+    uint32_t frames_rendered = 0;
+    auto ms = [](steady_clock::time_point from, steady_clock::time_point to) {
+      return duration<float, std::milli>(to - from).count();
+    };
+    // uploads of scene loading don't belong to the first frame
+    UploadStats::take();
+    while (!glfwWindowShouldClose(gl_window) && (frame_count == 0 || frames_rendered < frame_count))
     {
+      FURY_PROFILE_SCOPE("Frame");
       steady_clock::time_point frame_time_start = steady_clock::now();
+      RingBuffer::begin_frame();
+      GpuTimers::instance().begin_frame();
+      const steady_clock::time_point sync_end = steady_clock::now();
       if ((steady_clock::now() - fps_timer) >= 1s)
       {
         m_render_info.fps = frame_count_per_sec;
@@ -219,61 +211,132 @@ namespace fury
         fps_timer += 1s;
       }
       const float dt = m_render_info.frame_time;
+      if (benchmark)
+      {
+        const FrameBenchmark::CameraPose pose = benchmark->get_camera_pose(get_bbox(), frames_rendered);
+        m_camera.set_position(pose.position);
+        m_camera.look_at(pose.target);
+      }
       glfwPollEvents();
       tick(dt);
+      const steady_clock::time_point tick_end = steady_clock::now();
       glPolygonMode(GL_FRONT_AND_BACK, m_polygon_mode);
 
       const int w = m_window->width();
       const int h = m_window->height();
-      // render to a custom framebuffer
-      if (m_MSAA_enabled)
+      // g-buffer isn't multisampled, so deferred shading renders without MSAA
       {
-        main_fbo_ms.bind();
-      }
-      else
-      {
-        main_fbo.bind();
-      }
-      glClearColor(0.07f, 0.13f, 0.17f, 1.0f);
-      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-      glEnable(GL_DEPTH_TEST);
-      // render scene before gui to make sure that imgui window always will be on top of drawn entities
-      if (m_camera.get_projection_mode() == Camera::ProjectionMode::PERSPECTIVE)
-      {
-        render_skybox();
-      }
-      for (auto& rp : m_render_passes)
-      {
-        rp->tick(dt);
+        FURY_PROFILE_SCOPE("Render graph");
+        build_render_graph(w, h, m_MSAA_enabled && !m_deferred_shading_enabled, dt);
+        if (m_render_graph.compile())
+        {
+          m_render_graph.execute();
+        }
       }
-      DebugPass::instance().tick(dt);
-      m_ui.tick(dt);
-
-      if (m_MSAA_enabled)
+      const steady_clock::time_point render_end = steady_clock::now();
       {
-        // copy pixels from MSAA FBO to FBO that's texture is being rendered
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, main_fbo_ms.id());
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, main_fbo.id());
-        glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        FURY_PROFILE_SCOPE("FPSLimiter::wait");
+        m_fps_limiter.wait();
       }
-      glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-      m_screen_quad.tick(dt);
-      if (m_show_shadow_map)
+      m_render_info.target_frame_time = m_fps_limiter.get_target_frame_time();
+      m_render_info.achieved_frame_time = m_fps_limiter.get_achieved_frame_time();
+      m_render_info.frame_time_jitter = m_fps_limiter.get_jitter();
+      const steady_clock::time_point swap_start = steady_clock::now();
+      glfwSwapBuffers(gl_window);
+      RingBuffer::end_frame();
+      m_render_info.upload_bytes = UploadStats::take();
+      if (benchmark)
       {
-        m_shadow_map_quad.tick(dt);
+        const steady_clock::time_point frame_end = steady_clock::now();
+        // waiting for fences of older frames
+        benchmark->add_phase_time("Frame sync", ms(frame_time_start, sync_end));
+        benchmark->add_phase_time("Tick", ms(sync_end, tick_end));
+        benchmark->add_phase_time("Render", ms(tick_end, render_end));
+        benchmark->add_phase_time("Swap buffers", ms(swap_start, frame_end));
+        benchmark->add_frame(ms(frame_time_start, frame_end), m_render_info.upload_bytes);
       }
-      m_fps_limiter.wait();
-      glfwSwapBuffers(gl_window);
       frame_count_per_sec++;
       m_render_info.frame_time = std::chrono::duration<float>(frame_time_start - prev_frame_time).count();
       prev_frame_time = frame_time_start;
       SceneGraphManager::clear_dirty_nodes();
+      frames_rendered++;
     }
+    if (frame_count > 0 && frames_rendered > 0)
+    {
+      // time includes GPU work of the last frames
+      glFinish();
+      const float seconds = duration<float>(steady_clock::now() - run_start).count();
+      Logger::info("Rendered {} frames in {:.3f} s: {:.3f} ms per frame, {:.1f} fps", frames_rendered, seconds,
+        seconds * 1000.f / frames_rendered, frames_rendered / seconds);
+    }
+#ifdef FURY_ENABLE_PROFILER
+    Profiler::dump_chrome_trace(PROFILER_TRACE_FILE);
+#endif
+  }
+
+  void Scene::build_render_graph(int w, int h, bool msaa, float dt)
+  {
+    m_render_graph.reset();
+    const int samples = msaa ? 4 : 1;
+    // resolved by blit straight to window framebuffer, blit with multisampled side requires identical formats
+    const RenderGraph::ResourceId color = m_render_graph.create_texture("scene_color", { w, h, GL_RGBA8, samples });
+    // hi-z and deferred lighting blit depth, so its format must stay GL_DEPTH24_STENCIL8
+    const RenderGraph::ResourceId depth = m_render_graph.create_texture("scene_depth", { w, h, GL_DEPTH24_STENCIL8, samples });
+    const RenderGraph::ResourceId backbuffer = m_render_graph.import_framebuffer("backbuffer", 0);
+    const RenderGraph::PassId scene_pass = m_render_graph.add_pass("scene",
+      [&](RenderGraph::PassBuilder& builder) { builder.attach(color); builder.attach(depth); },
+      [this, dt]()
+      {
+        glClearColor(0.07f, 0.13f, 0.17f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        glEnable(GL_DEPTH_TEST);
+        // render scene before gui to make sure that imgui window always will be on top of drawn entities
+        if (m_camera.get_projection_mode() == Camera::ProjectionMode::PERSPECTIVE)
+        {
+          GpuTimerScope timer("Skybox");
+          render_skybox();
+        }
+        for (auto& rp : m_render_passes)
+        {
+          GpuTimerScope timer(rp->get_name());
+          rp->tick(dt);
+        }
+        {
+          GpuTimerScope timer("Debug");
+          DebugPass& debug_pass = DebugPass::instance();
+          for (const auto& [a, b] : m_debug_lines)
+          {
+            debug_pass.draw_line(a, b);
+          }
+          if (m_debug_frustum)
+          {
+            debug_pass.draw_frustum(*m_debug_frustum, glm::vec4(0, 1, 0, 1));
+          }
+          debug_pass.tick(dt);
+        }
+        GpuTimerScope timer("ImGui");
+        m_ui.tick(dt);
+      });
+    // nothing post-processes scene color, so it's resolved straight to window instead of being drawn with screen quad
+    m_render_graph.add_pass("present",
+      [&](RenderGraph::PassBuilder& builder) { builder.read(color); builder.attach(backbuffer); },
+      [this, scene_pass, w, h, dt]()
+      {
+        {
+          GpuTimerScope timer("Present blit");
+          glBindFramebuffer(GL_READ_FRAMEBUFFER, m_render_graph.get_framebuffer(scene_pass));
+          glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+        if (m_show_shadow_map)
+        {
+          m_shadow_map_quad.tick(dt);
+        }
+      });
   }
 
   void Scene::save(const std::string& file) const
   {
+    FURY_PROFILE_SCOPE("Scene::save");
     std::ofstream ofs(file, std::ios_base::binary);
     if (!ofs.is_open())
     {
@@ -292,6 +355,7 @@ namespace fury
 
   void Scene::load(const std::string& file)
   {
+    FURY_PROFILE_SCOPE("Scene::load");
     std::ifstream ifs(file, std::ios_base::binary);
     if (!ifs.is_open())
     {
@@ -302,9 +366,19 @@ namespace fury
     SceneGraphManager::clear();
     EntityManager::clear();
     serializer::prepare_for_serialization();
+    m_version = 0;
     Serializer<Scene>::read(ifs, this);
     SceneGraphManager::read(ifs);
     ifs.close();
+    if (m_version < 1)
+    {
+      // color used to be written into vertices too, so shader would apply it twice
+      for (auto& drawable : m_drawables)
+      {
+        ::reset_baked_vertex_color(*drawable);
+      }
+    }
+    m_version = version;
     prepare_scene_for_rendering();
   }
 
@@ -335,50 +409,15 @@ namespace fury
       {
         return;
       }
-      y = static_cast<int>(m_camera.get_screen_size().y) - y;
-      Ray ray = m_camera.cast_ray(x, y);
-      std::pair<Object3D*, float> hit_info = { nullptr, INFINITY };
-#if DEBUG_RAY
-      std::vector<Polyline> rays;
-#endif
-      for (const auto& d : m_drawables)
-      {
-        TransformationSceneNode* node = SceneGraphManager::get_entity_node<TransformationSceneNode>(d->get_id());
-        const glm::mat4 inv_model_mat = glm::inverse(node->get_world_mat());
-        Ray ray_local =
-            Ray(inv_model_mat * glm::vec4(ray.get_origin(), 1), inv_model_mat * glm::vec4(ray.get_direction(), 0));
-        if (auto hit = ray_local.intersect_object3d(d.get()))
-        {
-          const glm::vec3 ray_hit_pos_world = node->get_world_mat() * glm::vec4(hit->position, 1);
-#if DEBUG_RAY
-          Polyline poly;
-          poly.add(ray.get_origin());
-          poly.add(ray_hit_pos_world);
-          // auto dist = glm::distance(ray.get_origin(), glm::vec3(d->model_matrix() * glm::vec4(hit->position, 1)));
-          // std::cout << "dist " << d->name() << " " << dist << '\n';
-          rays.push_back(poly);
-#endif
-          // calculate distance in world space and find closest object. my guess is that we cannot use rayhit->distance
-          // here, because it's in local space, therefore, if ray instersects multiple objects, the object that is
-          // further may have less distance value than the object that is closer.
-          const float hit_distance_world = glm::distance2(ray.get_origin(), ray_hit_pos_world);
-          if (hit_info.second > hit_distance_world)
-          {
-            hit_info.second = hit_distance_world;
-            hit_info.first = const_cast<Object3D*>(d.get());
-          }
-        }
-      }
-      if (hit_info.first)
-      {
-        select_object(hit_info.first, false);
-      }
-#if DEBUG_RAY
-      for (auto& r : rays)
+      // do not pick object that is behind imgui's menu
+      if (ImGui::GetIO().WantCaptureMouse)
       {
-        scene.m_drawables.push_back(std::make_unique<Polyline>(r));
+        return;
       }
-#endif
+      // pixel rows go from bottom
+      y = static_cast<int>(m_camera.get_screen_size().y) - 1 - y;
+      // object is selected when id under cursor is read back, see update_picking()
+      m_picking_pass->request(x, y);
     }
   }
 
@@ -392,29 +431,7 @@ namespace fury
     m_window->set_width(width);
     m_window->set_height(height);
     m_camera.set_screen_size({ width, height });
-    for (auto& [name, fbo] : m_fbos)
-    {
-      if (name == "shadowMap")
-      {
-        continue;
-      }
-      fbo.bind();
-      if (auto& tex = fbo.texture())
-      {
-        tex->resize(width, height, fbo.texture()->internal_fmt(), fbo.texture()->format(),
-                    fbo.texture()->pixel_data_type());
-      }
-      if (auto& texMS = fbo.texture_ms())
-      {
-        // multisample texture is immutable, so replace old one with the new one
-        fbo.attach_texture_ms(Texture2DMS(width, height, texMS->get_format(), texMS->get_samples()));
-      }
-      RenderBufferCreateInfo info = fbo.get_info();
-      info.w = width;
-      info.h = height;
-      fbo.attach_renderbuffer(info);
-      fbo.unbind();
-    }
+    // render graph recreates its textures when their size changes
     glViewport(0, 0, width, height);
   }
 
@@ -451,7 +468,7 @@ namespace fury
       TransformationSceneNode* selected_transform =
           SceneGraphManager::get_entity_node<TransformationSceneNode>(selected_obj->get_id());
       float distance = INFINITY;
-      DebugPass::instance().clear();
+      m_debug_lines.clear();
       for (const glm::vec3& p : points)
       {
         Ray ray(selected_transform->get_world_mat() * glm::vec4(p, 1), glm::vec3(0, -1, 0));
@@ -468,7 +485,7 @@ namespace fury
                           drawable_transform->get_world_mat() * glm::vec4(drawable->get_bbox().max(), 1));
           if (auto hit = ray.intersect_aabb(bbox_world))
           {
-            DebugPass::instance().add_line(ray.get_origin(), hit->position);
+            m_debug_lines.emplace_back(ray.get_origin(), hit->position);
             // Logger::info("hit {} distance {}", hit->position, hit->distance);
             distance = std::min(hit->distance, distance);
           }
@@ -479,7 +496,6 @@ namespace fury
         glm::vec3 old = selected_transform->get_translation();
         distance = distance - old.y;
         selected_transform->set_translation(glm::vec3(old.x, -distance, old.z));
-        update_shadow_map();
       }
     }
     else if (input_code == InputCode::FURY_KEY_BACKSPACE && !m_selected_objects.empty())
@@ -510,13 +526,15 @@ namespace fury
     }
     else if (input_code == InputCode::FURY_KEY_M)
     {
-      Frustum fr = m_camera.get_frustum();
-      auto& dbg = DebugPass::instance();
-      for (const auto& [p1, p2] : fr.debug_lines)
-      {
-        dbg.add_line(p1, p2, glm::vec4(0, 1, 0, 1));
-      }
+      // freeze current camera frustum
+      m_debug_frustum = m_camera.get_projection_matrix() * m_camera.get_view_matrix();
+    }
+#ifdef FURY_ENABLE_PROFILER
+    else if (input_code == InputCode::FURY_KEY_F9)
+    {
+      Profiler::dump_chrome_trace(PROFILER_TRACE_FILE);
     }
+#endif
   }
 
   void Scene::change_polygon_mode(int new_mode)
@@ -528,21 +546,32 @@ namespace fury
   {
     if (info.new_transform)
     {
-      calculate_scene_bbox();
-      update_shadow_map();
-      if (m_MSAA_enabled)
+      m_bbox_dirty = true;
+      const Object3D* obj = info.object;
+      if (obj->get_bbox().is_empty())
       {
-        m_fbos.at("mainMS").bind();
+        invalidate_shadow_map();
+        return;
       }
-      else
+      const BoundingBox world_bbox = obj->get_bbox().transformed(info.new_transform->get_world_mat());
+      auto [it, inserted] = m_shadow_casters_bounds.try_emplace(obj, world_bbox);
+      const BoundingBox old_world_bbox = it->second;
+      it->second = world_bbox;
+      // new object goes straight to static cache, its world matrix may be not updated yet
+      if (inserted)
       {
-        m_fbos.at("main").bind();
+        invalidate_shadow_map();
+      }
+      else if (m_shadows_pass->intersects_cascades(world_bbox) || m_shadows_pass->intersects_cascades(old_world_bbox))
+      {
+        m_shadows_pass->mark_dynamic(obj, old_world_bbox, world_bbox);
       }
     }
   }
 
   void Scene::calculate_scene_bbox()
   {
+    m_bbox_dirty = false;
     m_bbox.reset();
     for (auto& drawable : m_drawables)
     {
@@ -563,24 +592,32 @@ namespace fury
 
   void Scene::update_shadow_map()
   {
-    auto& shadows_fbo = m_fbos.at("shadowMap");
-    shadows_fbo.bind();
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
-    // glEnable(GL_POLYGON_OFFSET_FILL);
-    // glPolygonOffset(1, 1);
     // TODO: gap between coplanar planes ...
-    // glCullFace(GL_FRONT);
-    glViewport(0, 0, SHADOWMAP_WIDTH, SHADOWMAP_HEIGHT);
-    glClear(GL_DEPTH_BUFFER_BIT);
+    GpuTimerScope timer(m_shadows_pass->get_name());
     m_shadows_pass->update();
-    glCullFace(GL_BACK);
-    glEnable(GL_CULL_FACE);
-    // glDisable(GL_POLYGON_OFFSET_FILL);
-    shadows_fbo.unbind();
     glViewport(0, 0, m_window->width(), m_window->height());
   }
 
+  void Scene::update_picking()
+  {
+    if (std::optional<uint32_t> id = m_picking_pass->take_result(); id && EntityManager::has_entity(*id))
+    {
+      Entity* entity = EntityManager::get_entity(*id);
+      if (entity->is_a(Object3D::get_static_type_id()))
+      {
+        select_object(static_cast<Object3D*>(entity), false);
+      }
+    }
+    GpuTimerScope timer(m_picking_pass->get_name());
+    m_picking_pass->update();
+    glViewport(0, 0, m_window->width(), m_window->height());
+  }
+
+  void Scene::invalidate_shadow_map()
+  {
+    m_shadows_pass->invalidate_static_cache();
+  }
+
   void Scene::handle_ui_component_opening()
   {
     m_camera.freeze();
@@ -603,33 +640,37 @@ namespace fury
     m_MSAA_enabled = enabled;
   }
 
+  void Scene::handle_deferred_shading_button_toggle(bool enabled)
+  {
+    m_deferred_shading_enabled = enabled;
+  }
+
   void Scene::remove_object(Object3D* obj)
   {
     on_object_deleted.notify(obj);
     auto it = std::find_if(m_drawables.begin(), m_drawables.end(),
                            [=](const auto& drawable) { return drawable.get() == obj; });
     m_drawables.erase(it);
+    m_shadow_casters_bounds.erase(obj);
+    m_shadows_pass->forget(obj);
     for (auto& rp : m_render_passes)
     {
       rp->update();
     }
-    update_shadow_map();
+    invalidate_shadow_map();
     DebugPass::instance().update();
-    calculate_scene_bbox();
-    if (m_MSAA_enabled)
-    {
-      m_fbos.at("mainMS").bind();
-    }
-    else
-    {
-      m_fbos.at("main").bind();
-    }
+    m_bbox_dirty = true;
   }
 
   void Scene::cleanup()
   {
     // cleanup current scene
+    for (const auto& drawable : m_drawables)
+    {
+      m_shadows_pass->forget(drawable.get());
+    }
     m_drawables.clear();
+    m_shadow_casters_bounds.clear();
     m_selected_objects.clear();
     m_lights.clear();
     m_controllers.clear();
@@ -658,14 +699,12 @@ namespace fury
     const glm::vec3 bbox_center = m_bbox.center();
     const glm::vec3 dir_light_position = glm::vec3(bbox_center.x + 0.12, bbox_center.y + 0.33, bbox_center.z + 0.7);
     const glm::vec3 dir_light_target = bbox_center;
-    constexpr static float cube_bound = 6.f;
+    // shadow cascades are fitted to camera, so position only places light gizmo
+    constexpr static float light_distance = 6.f;
     LightDescription desc;
     desc.type = LightType::DIRECTIONAL;
     desc.dir = glm::vec4(glm::normalize(dir_light_target - dir_light_position), 1);
-    desc.position = glm::vec4(dir_light_position + cube_bound * -glm::vec3(desc.dir), 1);
-    const glm::mat4 proj_mat = glm::ortho<float>(-cube_bound, cube_bound, -cube_bound, cube_bound, -10.f, 10.f);
-    const glm::mat4 view_mat = glm::lookAt(dir_light_position, dir_light_target, glm::vec3(0, 1, 0));
-    desc.shadow_matrix = proj_mat * view_mat;
+    desc.position = glm::vec4(dir_light_position + light_distance * -glm::vec3(desc.dir), 1);
     TransformationSceneNode* transform = light->attach_node<TransformationSceneNode>();
     transform->set_translation(desc.position);
     light->set_description(desc);
@@ -789,6 +828,128 @@ namespace fury
     prepare_scene_for_rendering();
   }
 
+  void Scene::create_stress_scene(const stress_scene::Config& config)
+  {
+    using stress_scene::ObjectKind;
+    cleanup();
+    const stress_scene::Plan plan = stress_scene::make_plan(config);
+    Logger::info("Generating stress scene of {} objects and {} lights with seed {}.", plan.objects.size(),
+      plan.lights.size(), config.seed);
+    if (!SceneGraphManager::get_entity_node<TransformationSceneNode>(m_camera.get_id()))
+    {
+      m_camera.attach_node<TransformationSceneNode>();
+    }
+    m_camera.set_position(glm::vec3(0.f, plan.half_extent * 0.5f, plan.half_extent * 1.5f));
+    m_camera.look_at(glm::vec3(0.f));
+
+    // objects of the same kind and variant share meshes, so their geometry is stored once
+    Cube cube;
+    cube.apply_shading(Object3D::ShadingMode::FLAT_SHADING);
+    std::vector<std::shared_ptr<std::vector<Mesh>>> cube_meshes = { cube.get_meshes_data() };
+    // one variant per texture, untextured cube isn't used then
+    for (uint32_t i = 1; i < config.texture_count; i++)
+    {
+      cube_meshes.push_back(std::make_shared<std::vector<Mesh>>(*cube_meshes.front()));
+    }
+    for (uint32_t i = 0; i < config.texture_count; i++)
+    {
+      constexpr int texture_size = 64;
+      const std::vector<uint8_t> pixels = stress_scene::make_texture_pixels(i, texture_size);
+      auto texture = std::make_shared<Texture2D>(texture_size, texture_size, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+      texture->bind();
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texture_size, texture_size, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+      texture->unbind();
+      texture->enable();
+      cube_meshes[i]->front().set_texture(texture, TextureType::DIFFUSE);
+    }
+    Icosahedron ico;
+    ico.subdivide_triangles(2);
+    ico.project_points_on_sphere();
+    ico.apply_shading(Object3D::ShadingMode::SMOOTH_SHADING);
+    const std::shared_ptr<std::vector<Mesh>> ico_meshes = ico.get_meshes_data();
+    std::vector<std::shared_ptr<std::vector<Mesh>>> model_meshes;
+    for (const std::string& file : config.model_files)
+    {
+      Object3D model;
+      const unsigned int assimp_flags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices
+        | aiProcess_GenBoundingBoxes;
+      ModelLoader loader;
+      // instances of model that failed to load become cubes
+      model_meshes.push_back(loader.load(file, assimp_flags, model) ? model.get_meshes_data() : cube_meshes.front());
+    }
+
+    m_drawables.reserve(plan.objects.size());
+    std::vector<TransformationSceneNode*> nodes;
+    nodes.reserve(plan.objects.size());
+    for (const stress_scene::ObjectSpec& spec : plan.objects)
+    {
+      Object3D* obj = nullptr;
+      if (spec.kind == ObjectKind::CURVE)
+      {
+        auto curve = std::make_unique<BezierCurve>(BezierCurveType::Quadratic);
+        curve->set_start_point(Vertex());
+        curve->set_end_point(Vertex(spec.curve_end));
+        curve->set_control_points({ Vertex(spec.curve_control) });
+        obj = m_drawables.emplace_back(std::move(curve)).get();
+      }
+      else
+      {
+        obj = m_drawables.emplace_back(std::make_unique<Object3D>()).get();
+        if (spec.kind == ObjectKind::ICOSAHEDRON)
+        {
+          obj->set_meshes_data(ico_meshes);
+          obj->set_shading_mode(Object3D::ShadingMode::SMOOTH_SHADING);
+        }
+        else if (spec.kind == ObjectKind::MODEL)
+        {
+          obj->set_meshes_data(model_meshes[spec.variant]);
+        }
+        else
+        {
+          obj->set_meshes_data(cube_meshes[std::max(spec.variant, 0)]);
+          obj->set_shading_mode(Object3D::ShadingMode::FLAT_SHADING);
+        }
+      }
+      obj->set_color(spec.color);
+      TransformationSceneNode* transform = obj->attach_node<TransformationSceneNode>();
+      if (spec.parent >= 0)
+      {
+        transform->set_parent(nodes[spec.parent]);
+      }
+      transform->set_translation(spec.translation);
+      transform->set_scale(glm::vec3(spec.scale));
+      nodes.push_back(transform);
+      if (spec.animated)
+      {
+        auto& controller = m_controllers.emplace_back(new RotationController(spec.rotation_axis, spec.rotation_speed));
+        controller->set_entity(obj);
+      }
+      EntityManager::add_entity(obj);
+    }
+
+    // directional light is aimed at scene center, objects' bounds aren't calculated yet
+    m_bbox.init(glm::vec3(-plan.half_extent), glm::vec3(plan.half_extent));
+    m_lights.reserve(plan.lights.size() + 2);
+    create_default_lights();
+    for (const stress_scene::LightSpec& spec : plan.lights)
+    {
+      LightDescription desc;
+      desc.type = LightType::POINT;
+      desc.position = glm::vec4(spec.position, 1.f);
+      // many lights would wash the scene out with ambient term
+      desc.ambient = glm::vec4(0.f);
+      desc.diffuse = glm::vec4(spec.color, 1.f);
+      desc.specular = glm::vec4(spec.color, 1.f);
+      Light& light = m_lights.emplace_back(desc);
+      light.attach_node<TransformationSceneNode>()->set_translation(spec.position);
+    }
+    for (Light& light : m_lights)
+    {
+      EntityManager::add_entity(&light);
+    }
+    prepare_scene_for_rendering();
+  }
+
   void Scene::prepare_scene_for_rendering()
   {
     for (auto& drawable : m_drawables)
@@ -799,6 +960,8 @@ namespace fury
       }
       // calculate object center + bbox
       drawable->update();
+      // levels of detail aren't serialized
+      drawable->generate_lods();
     }
 
     calculate_scene_bbox();
@@ -857,29 +1020,34 @@ namespace fury
 
   void Scene::tick(float dt)
   {
+    FURY_PROFILE_SCOPE("Scene::tick");
     for (const auto& c : m_controllers)
     {
       c->tick(dt);
     }
     m_cam_controller.tick(dt);
 
-    for (SceneNode* node : SceneGraphManager::get_dirty_nodes())
     {
-      node->update();
-      if (Entity* owner = node->get_owner(); owner->is_a(Object3D::get_static_type_id()))
+      FURY_PROFILE_SCOPE("Dirty nodes");
+      for (SceneNode* node : SceneGraphManager::get_dirty_nodes())
       {
-        Object3D* obj = static_cast<Object3D*>(node->get_owner());
-        ObjectChangeInfo change_info;
-        change_info.object = obj;
-        change_info.new_transform = static_cast<TransformationSceneNode*>(node);
-        global_state::g_on_object_change.notify(change_info);
+        node->update();
+        if (Entity* owner = node->get_owner(); owner->is_a(Object3D::get_static_type_id()))
+        {
+          Object3D* obj = static_cast<Object3D*>(node->get_owner());
+          ObjectChangeInfo change_info;
+          change_info.object = obj;
+          change_info.new_transform = static_cast<TransformationSceneNode*>(node);
+          global_state::g_on_object_change.notify(change_info);
+        }
       }
     }
+    // all changes of the frame are accumulated by now, cascades follow camera
+    update_shadow_map();
+    update_picking();
 
-    UniformBuffer& ubo = PipelineUBOManager::get("cameraData");
-    ubo.bind();
-    ubo.set_data(&m_camera.get_view_matrix(), sizeof(glm::mat4), 0);
-    ubo.set_data(&m_camera.get_projection_matrix(), sizeof(glm::mat4), sizeof(glm::mat4));
-    ubo.unbind();
+    const std::array camera_data = { m_camera.get_view_matrix(), m_camera.get_projection_matrix() };
+    RingBuffer::Allocation camera_data_alloc = m_camera_data_ring.push(camera_data.data(), sizeof(camera_data));
+    m_camera_data_ring.bind_range(0, camera_data_alloc.offset, sizeof(camera_data));
   }
 } // namespace fury
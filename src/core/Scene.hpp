@@ -1,7 +1,8 @@
 #pragma once
 
 #include "Camera.hpp"
-#include "opengl/FrameBufferObject.hpp"
+#include "RenderGraph.hpp"
+#include "opengl/RingBuffer.hpp"
 #include "input/InputSystem.hpp"
 #include "CameraController.hpp"
 #include "ui/Ui.hpp"
@@ -18,10 +19,15 @@
 #include "core/ObjectController.hpp"
 #include "Singleton.hpp"
 #include "RenderInfo.hpp"
+#include "StressScene.hpp"
+#include "FrameBenchmark.hpp"
 #include <vector>
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <optional>
+#include <utility>
 
 namespace fury
 {
@@ -32,6 +38,8 @@ namespace fury
   {
   public:
     FURY_REGISTER_BASE_CLASS(Scene)
+    // format of saved scenes. 1: object color is a tint, it isn't baked into vertex colors
+    constexpr static uint32_t version = 1;
     void tick(float dt) override;
     void init(WindowGLFW* window);
     ~Scene();
@@ -39,19 +47,25 @@ namespace fury
     Camera& get_camera() { return m_camera; }
     std::vector<Object3D*>& get_selected_objects() { return m_selected_objects; }
     std::vector<std::unique_ptr<Object3D>>& get_drawables() { return m_drawables; }
-    BoundingBox& get_bbox() { return m_bbox; }
+    // scene bbox is recalculated lazily after objects have moved
+    BoundingBox& get_bbox() { if (m_bbox_dirty) calculate_scene_bbox(); return m_bbox; }
     WindowGLFW* get_window() { return m_window; }
     Ui& get_ui() { return m_ui; }
     std::vector<const Light*> get_active_lights() const;
     std::vector<Light>& get_lights() { return m_lights; }
     std::vector<Light*> get_lights(LightType type);
     void create_default_scene();
-    void render();
+    // replaces current scene with generated one
+    void create_stress_scene(const stress_scene::Config& config);
+    // renders until window is closed or frame_count frames are rendered, if it's not 0.
+    // benchmark drives camera and receives timings of frames
+    void render(uint32_t frame_count = 0, FrameBenchmark* benchmark = nullptr);
     void save(const std::string& file) const;
     void load(const std::string& file);
     void clear();
     void set_fps_limit(uint32_t fps) { m_fps_limiter.set_limit(fps); }
     uint32_t get_fps_limit() const { return m_fps_limiter.get_limit(); }
+    bool is_deferred_shading_enabled() const { return m_deferred_shading_enabled; }
     Event<Object3D*> on_new_object_added;
     Event<Object3D*> on_object_deleted;
     // These have to be complete types...
@@ -60,7 +74,8 @@ namespace fury
       FURY_SERIALIZABLE_FIELD(2, &Scene::m_polygon_mode),
       FURY_SERIALIZABLE_FIELD(3, &Scene::m_drawables),
       FURY_SERIALIZABLE_FIELD(4, &Scene::m_lights),
-      FURY_SERIALIZABLE_FIELD(5, &Scene::m_controllers)
+      FURY_SERIALIZABLE_FIELD(5, &Scene::m_controllers),
+      FURY_SERIALIZABLE_FIELD(6, &Scene::m_version)
     )
   private:
     Scene() = default;
@@ -69,6 +84,8 @@ namespace fury
     void prepare_scene_for_rendering();
     void select_object(Object3D* obj, bool click_from_menu_item);  // temporary function. remove when selection of multiple elements is supported
     void render_skybox();
+    // scene targets and passes of the frame
+    void build_render_graph(int w, int h, bool msaa, float dt);
     void handle_mouse_click(InputCode, int x, int y);
     void handle_window_size_change(int width, int height);
     void handle_keyboard_button_click(InputCode input_code);
@@ -76,9 +93,14 @@ namespace fury
     void handle_object_change(const ObjectChangeInfo& info);
     void calculate_scene_bbox();
     void update_shadow_map();
+    // selects object of finished click readback and renders pending click
+    void update_picking();
+    // shadow cascades are updated once per frame, at the end of tick
+    void invalidate_shadow_map();
     void handle_ui_component_opening();
     void handle_ui_component_closing();
     void handle_msaa_button_toggle(bool enabled);
+    void handle_deferred_shading_button_toggle(bool enabled);
     void remove_object(Object3D* obj);
     void cleanup();
     void setup_directional_light(Light* light);
@@ -87,25 +109,35 @@ namespace fury
   private:
     // store pointers to make virtual methods work
     std::vector<std::unique_ptr<Object3D>> m_drawables;
+    // version of the loaded file, scenes saved without it have version 0
+    uint32_t m_version = version;
     std::vector<Object3D*> m_selected_objects;
     std::vector<std::unique_ptr<RenderPass>> m_render_passes;
     std::unique_ptr<ShadowsPass> m_shadows_pass;
+    std::unique_ptr<PickingPass> m_picking_pass;
     std::vector<Light> m_lights;
     std::vector<std::unique_ptr<ObjectController>> m_controllers;
-    ScreenQuad m_screen_quad;
     ScreenQuad m_shadow_map_quad;
     bool m_show_shadow_map = false;
     bool m_MSAA_enabled = true;
+    bool m_deferred_shading_enabled = false;
     Skybox m_skybox;
     WindowGLFW* m_window;
     Ui m_ui;
     CameraController m_cam_controller;
     Camera m_camera;
-    std::map<std::string, FrameBufferObject> m_fbos;
+    RenderGraph m_render_graph;
+    RingBuffer m_camera_data_ring = RingBuffer(GL_UNIFORM_BUFFER);
     GLint m_polygon_mode = GL_FILL;
     BoundingBox m_bbox;
+    // world bounds of objects at their last change, moving object affects shadow map only if it was or is in shadow cascades
+    std::unordered_map<const Object3D*, BoundingBox> m_shadow_casters_bounds;
+    bool m_bbox_dirty = false;
     FPSLimiter m_fps_limiter;
     ItemSelectionWheel m_selection_wheel;
     RenderInfo m_render_info;
+    // debug primitives are transient, these are submitted every frame
+    std::vector<std::pair<glm::vec3, glm::vec3>> m_debug_lines;
+    std::optional<glm::mat4> m_debug_frustum;
   };
 }
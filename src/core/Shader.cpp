@@ -8,6 +8,7 @@
 #include <fstream>
 #include <exception>
 #include <filesystem>
+#include <cstring>
 
 static bool read_shader_file_content(const char* const file, std::string& content) 
 {
@@ -44,7 +45,9 @@ namespace fury
 
   void Shader::load(const ShaderDescription& description)
   {
-    if (description.sources.size() < 2)
+    // compute program is the only one that consists of a single stage
+    const bool is_compute = description.sources.size() == 1 && description.sources[0].first == ShaderStage::COMPUTE;
+    if (description.sources.size() < 2 && !is_compute)
     {
       Logger::error("Invalid shader description (size < 2).");
       return;
@@ -82,37 +85,185 @@ namespace fury
       }
       glDeleteShader(shader);
     }
-    check_shader(m_id.id, description.name);
+    if (check_shader(m_id.id, description.name))
+    {
+      reflect();
+    }
+  }
+
+  void Shader::reflect()
+  {
+    m_uniforms.clear();
+    m_uniform_blocks.clear();
+    m_uniform_indices.clear();
+
+    GLint count = 0;
+    GLint max_name_len = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_len);
+    std::string name(max_name_len, '\0');
+    for (GLint i = 0; i < count; i++)
+    {
+      GLsizei name_len = 0;
+      GLint size = 0;
+      GLenum type = 0;
+      glGetActiveUniform(m_id, static_cast<GLuint>(i), max_name_len, &name_len, &size, &type, name.data());
+      const GLint location = glGetUniformLocation(m_id, name.c_str());
+      // members of uniform blocks don't have location
+      if (location < 0)
+      {
+        continue;
+      }
+      const int index = static_cast<int>(m_uniforms.size());
+      UniformInfo& info = m_uniforms.emplace_back();
+      info.name.assign(name.data(), name_len);
+      info.location = location;
+      info.type = type;
+      info.size = size;
+      m_uniform_indices[info.name] = index;
+      // arrays are reported as "name[0]", allow to find them by "name" too
+      if (info.name.ends_with("[0]"))
+      {
+        m_uniform_indices[info.name.substr(0, info.name.size() - 3)] = index;
+      }
+    }
+
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_name_len);
+    name.assign(max_name_len, '\0');
+    for (GLint i = 0; i < count; i++)
+    {
+      GLsizei name_len = 0;
+      UniformBlockInfo& info = m_uniform_blocks.emplace_back();
+      info.index = static_cast<GLuint>(i);
+      glGetActiveUniformBlockName(m_id, info.index, max_name_len, &name_len, name.data());
+      info.name.assign(name.data(), name_len);
+      glGetActiveUniformBlockiv(m_id, info.index, GL_UNIFORM_BLOCK_BINDING, &info.binding);
+      glGetActiveUniformBlockiv(m_id, info.index, GL_UNIFORM_BLOCK_DATA_SIZE, &info.data_size);
+    }
+  }
+
+  int Shader::find_uniform(std::string_view name)
+  {
+    std::string key(name);
+    auto it = m_uniform_indices.find(key);
+    if (it != m_uniform_indices.end())
+    {
+      return it->second;
+    }
+    // reflection lists only first element of basic type arrays, so "name[i]" has to be queried.
+    // also remember inactive names so that they are not queried again
+    const GLint location = glGetUniformLocation(m_id, key.c_str());
+    int index = -1;
+    if (location >= 0)
+    {
+      index = static_cast<int>(m_uniforms.size());
+      UniformInfo& info = m_uniforms.emplace_back();
+      info.name = key;
+      info.location = location;
+      info.size = 1;
+    }
+    m_uniform_indices.emplace(std::move(key), index);
+    return index;
+  }
+
+  bool Shader::update_cached_value(int index, const void* value, size_t size)
+  {
+    if (index < 0)
+    {
+      return false;
+    }
+    UniformInfo& info = m_uniforms[index];
+    if (info.has_cached_value && std::memcmp(info.cached_value.data(), value, size) == 0)
+    {
+      return false;
+    }
+    std::memcpy(info.cached_value.data(), value, size);
+    info.has_cached_value = true;
+    return true;
+  }
+
+  void Shader::set_uniform(int index, const glm::mat4& value)
+  {
+    if (update_cached_value(index, &value, sizeof(value)))
+    {
+      glProgramUniformMatrix4fv(m_id, m_uniforms[index].location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+  }
+
+  void Shader::set_uniform(int index, const glm::vec4& value)
+  {
+    if (update_cached_value(index, &value, sizeof(value)))
+    {
+      glProgramUniform4fv(m_id, m_uniforms[index].location, 1, glm::value_ptr(value));
+    }
+  }
+
+  void Shader::set_uniform(int index, const glm::vec3& value)
+  {
+    if (update_cached_value(index, &value, sizeof(value)))
+    {
+      glProgramUniform3fv(m_id, m_uniforms[index].location, 1, glm::value_ptr(value));
+    }
+  }
+
+  void Shader::set_uniform(int index, bool value)
+  {
+    set_uniform(index, static_cast<int>(value));
+  }
+
+  void Shader::set_uniform(int index, unsigned int value)
+  {
+    if (update_cached_value(index, &value, sizeof(value)))
+    {
+      glProgramUniform1ui(m_id, m_uniforms[index].location, value);
+    }
+  }
+
+  void Shader::set_uniform(int index, float value)
+  {
+    if (update_cached_value(index, &value, sizeof(value)))
+    {
+      glProgramUniform1f(m_id, m_uniforms[index].location, value);
+    }
+  }
+
+  void Shader::set_uniform(int index, int value)
+  {
+    if (update_cached_value(index, &value, sizeof(value)))
+    {
+      glProgramUniform1i(m_id, m_uniforms[index].location, value);
+    }
   }
 
   void Shader::set_matrix4f(const char* uniform_name, const glm::mat4& value)
   {
-    glUniformMatrix4fv(glGetUniformLocation(m_id, uniform_name), 1, GL_FALSE, glm::value_ptr(value));
+    set_uniform(find_uniform(uniform_name), value);
   }
 
   void Shader::set_vec3(const char* uniform_name, const glm::vec3& value)
   {
-    glUniform3fv(glGetUniformLocation(m_id, uniform_name), 1, glm::value_ptr(value));
+    set_uniform(find_uniform(uniform_name), value);
   }
 
   void Shader::set_bool(const char* uniform_name, bool value)
   {
-    set_int(uniform_name, value);
+    set_uniform(find_uniform(uniform_name), value);
   }
 
   void Shader::set_int(const char* uniform_name, int value)
   {
-    glUniform1i(glGetUniformLocation(m_id, uniform_name), value);
+    set_uniform(find_uniform(uniform_name), value);
   }
 
   void Shader::set_uint(const char* uniform_name, unsigned int value)
   {
-    glUniform1ui(glGetUniformLocation(m_id, uniform_name), value);
+    set_uniform(find_uniform(uniform_name), value);
   }
 
   void Shader::set_float(const char* uniform_name, float value)
   {
-    glUniform1f(glGetUniformLocation(m_id, uniform_name), value);
+    set_uniform(find_uniform(uniform_name), value);
   }
 
   void Shader::bind() const
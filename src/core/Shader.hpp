@@ -2,8 +2,12 @@
 
 #include "opengl/OpenGLObject.hpp"
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <array>
 #include <filesystem>
 
 namespace fury
@@ -13,6 +17,7 @@ namespace fury
     VERTEX = GL_VERTEX_SHADER,
     FRAGMENT = GL_FRAGMENT_SHADER,
     GEOMETRY = GL_GEOMETRY_SHADER,
+    COMPUTE = GL_COMPUTE_SHADER,
     UNKNOWN
   };
 
@@ -22,6 +27,27 @@ namespace fury
     std::string name;
   };
 
+  // active uniform of linked program, filled by reflection after link
+  struct UniformInfo
+  {
+    std::string name;
+    GLint location = -1;
+    GLenum type = 0;
+    // array size, 1 for non array uniforms
+    GLint size = 0;
+    // last uploaded value, used to skip redundant uploads
+    std::array<std::byte, sizeof(glm::mat4)> cached_value = {};
+    bool has_cached_value = false;
+  };
+
+  struct UniformBlockInfo
+  {
+    std::string name;
+    GLuint index = 0;
+    GLint binding = 0;
+    GLint data_size = 0;
+  };
+
   class Shader : public OpenGLObject
   {
   public:
@@ -36,9 +62,42 @@ namespace fury
     void set_uint(const char* uniform_name, unsigned int value);
     void set_float(const char* uniform_name, float value);
     void set_int(const char* uniform_name, int value);
+    // index into uniforms table or -1 if uniform is not active
+    int find_uniform(std::string_view name);
+    // uniforms are set through glProgramUniform*, so program doesn't have to be bound
+    void set_uniform(int index, const glm::mat4& value);
+    void set_uniform(int index, const glm::vec4& value);
+    void set_uniform(int index, const glm::vec3& value);
+    void set_uniform(int index, bool value);
+    void set_uniform(int index, unsigned int value);
+    void set_uniform(int index, float value);
+    void set_uniform(int index, int value);
+    const std::vector<UniformInfo>& get_uniforms() const { return m_uniforms; }
+    const std::vector<UniformBlockInfo>& get_uniform_blocks() const { return m_uniform_blocks; }
     void bind() const override;
     void unbind() const override;
   private:
     void load(const ShaderDescription& description);
+    void reflect();
+    // returns true if value differs from the last uploaded one
+    bool update_cached_value(int index, const void* value, size_t size);
+  private:
+    std::vector<UniformInfo> m_uniforms;
+    std::vector<UniformBlockInfo> m_uniform_blocks;
+    std::unordered_map<std::string, int> m_uniform_indices;
+  };
+
+  // uniform location resolved once, typically at pass construction
+  template<typename T>
+  class UniformHandle
+  {
+  public:
+    UniformHandle() = default;
+    UniformHandle(Shader* shader, std::string_view name) : m_shader(shader), m_index(shader->find_uniform(name)) {}
+    void set(const T& value) { if (m_shader) m_shader->set_uniform(m_index, value); }
+    bool is_valid() const { return m_index >= 0; }
+  private:
+    Shader* m_shader = nullptr;
+    int m_index = -1;
   };
 }
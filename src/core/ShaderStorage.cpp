@@ -24,6 +24,7 @@ namespace fury
         ShaderDescriptionInternal d;
         d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "default.vert" });
         d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "default.frag" });
+        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "lighting.frag" });
         d.shader_type = ShaderStorage::ShaderType::DEFAULT;
         d.name = "Default";
         descriptions.push_back(d);
@@ -71,7 +72,6 @@ namespace fury
       {
         ShaderDescriptionInternal d;
         d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "normals.vert" });
-        d.sources.push_back({ ShaderStage::GEOMETRY, GLSL_FOLDER / "normals.geom" });
         d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "normals.frag" });
         d.shader_type = ShaderStorage::ShaderType::NORMALS;
         d.name = "Normals";
@@ -87,10 +87,10 @@ namespace fury
       }
       {
         ShaderDescriptionInternal d;
-        d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "bounding_box.vert" });
-        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "simple.frag" });
-        d.shader_type = ShaderStorage::ShaderType::BOUNDING_BOX;
-        d.name = "Bounding box";
+        d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "debug_primitives.vert" });
+        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "simple_with_vcolor.frag" });
+        d.shader_type = ShaderStorage::ShaderType::DEBUG_PRIMITIVES;
+        d.name = "Debug primitives";
         descriptions.push_back(d);
       }
       {
@@ -119,10 +119,33 @@ namespace fury
       }
       {
         ShaderDescriptionInternal d;
-        d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "simple_with_vcolor.vert" });
-        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "simple_with_vcolor.frag" });
-        d.shader_type = ShaderStorage::ShaderType::SIMPLE_WITH_VCOLOR;
-        d.name = "Simple with color";
+        d.sources.push_back({ ShaderStage::COMPUTE, GLSL_FOLDER / "hiz_build.comp" });
+        d.shader_type = ShaderStorage::ShaderType::HIZ_BUILD;
+        d.name = "Hi-Z build";
+        descriptions.push_back(d);
+      }
+      {
+        ShaderDescriptionInternal d;
+        d.sources.push_back({ ShaderStage::COMPUTE, GLSL_FOLDER / "culling.comp" });
+        d.shader_type = ShaderStorage::ShaderType::CULLING;
+        d.name = "Culling";
+        descriptions.push_back(d);
+      }
+      {
+        ShaderDescriptionInternal d;
+        d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "default.vert" });
+        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "gbuffer.frag" });
+        d.shader_type = ShaderStorage::ShaderType::GBUFFER;
+        d.name = "G-buffer";
+        descriptions.push_back(d);
+      }
+      {
+        ShaderDescriptionInternal d;
+        d.sources.push_back({ ShaderStage::VERTEX, GLSL_FOLDER / "deferred_lighting.vert" });
+        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "deferred_lighting.frag" });
+        d.sources.push_back({ ShaderStage::FRAGMENT, GLSL_FOLDER / "lighting.frag" });
+        d.shader_type = ShaderStorage::ShaderType::DEFERRED_LIGHTING;
+        d.name = "Deferred lighting";
         descriptions.push_back(d);
       }
       for (const ShaderDescriptionInternal& desc : descriptions)
@@ -18,11 +18,14 @@ namespace fury
       SIMPLE,
       NORMALS,
       SHADOW_MAP,
-      BOUNDING_BOX,
+      DEBUG_PRIMITIVES,
       SELECTION_WHEEL,
       SELECTION_WHEEL_ICON,
       GRID,
-      SIMPLE_WITH_VCOLOR,
+      HIZ_BUILD,
+      CULLING,
+      GBUFFER,
+      DEFERRED_LIGHTING,
       LAST_ITEM
     };
     static void init();
@@ -0,0 +1,91 @@
+#include "ShadowCascades.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fury
+{
+  namespace shadow_cascades
+  {
+    std::array<float, count> compute_splits(float znear, float zfar, float lambda)
+    {
+      std::array<float, count> splits = {};
+      for (int i = 0; i < count; i++)
+      {
+        const float p = static_cast<float>(i + 1) / count;
+        const float log_split = znear * std::pow(zfar / znear, p);
+        const float uniform_split = znear + (zfar - znear) * p;
+        splits[i] = lambda * log_split + (1.f - lambda) * uniform_split;
+      }
+      return splits;
+    }
+
+    std::array<glm::vec3, 8> get_slice_corners(const glm::mat4& view, float fovy_deg, float aspect, float slice_near, float slice_far)
+    {
+      const glm::mat4 proj = glm::perspective(glm::radians(fovy_deg), aspect, slice_near, slice_far);
+      const glm::mat4 inv_view_proj = glm::inverse(proj * view);
+      std::array<glm::vec3, 8> corners;
+      for (int i = 0; i < 8; i++)
+      {
+        const glm::vec4 ndc((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : -1.f, 1.f);
+        const glm::vec4 world = inv_view_proj * ndc;
+        corners[i] = glm::vec3(world) / world.w;
+      }
+      return corners;
+    }
+
+    glm::mat4 fit(const std::array<glm::vec3, 8>& slice_corners, const glm::vec3& light_dir, const BoundingBox& scene_bbox, int resolution)
+    {
+      const glm::vec3 dir = glm::normalize(light_dir);
+      const glm::vec3 up = std::abs(dir.y) > 0.99f ? glm::vec3(0, 0, 1) : glm::vec3(0, 1, 0);
+      // rotation only
+      const glm::mat4 light_view = glm::lookAt(glm::vec3(0.f), dir, up);
+
+      glm::vec3 center(0.f);
+      for (const glm::vec3& corner : slice_corners)
+      {
+        center += corner;
+      }
+      center /= static_cast<float>(slice_corners.size());
+      float radius = 0.f;
+      for (const glm::vec3& corner : slice_corners)
+      {
+        radius = std::max(radius, glm::length(corner - center));
+      }
+      // radius depends only on slice shape, rounding removes float noise between frames
+      radius = std::ceil(radius * 16.f) / 16.f;
+      const float guard = radius * guard_fraction;
+      const float half_size = radius + guard;
+      const float texel_size = 2.f * half_size / resolution;
+      // snapped center is off by less than one step on each axis, guard margin keeps the slice inside
+      const float step = std::max(std::floor(guard / texel_size), 1.f) * texel_size;
+
+      glm::vec3 center_ls = light_view * glm::vec4(center, 1.f);
+      center_ls.x = std::floor(center_ls.x / step) * step;
+      center_ls.y = std::floor(center_ls.y / step) * step;
+
+      // view space looks down -z
+      float min_z = center_ls.z - half_size;
+      float max_z = center_ls.z + half_size;
+      if (!scene_bbox.is_empty())
+      {
+        min_z = std::numeric_limits<float>::max();
+        max_z = std::numeric_limits<float>::lowest();
+        for (const glm::vec3& point : scene_bbox.get_points())
+        {
+          const float z = (light_view * glm::vec4(point, 1.f)).z;
+          min_z = std::min(min_z, z);
+          max_z = std::max(max_z, z);
+        }
+      }
+      // scene bbox changes by small moves of objects don't change the matrix
+      min_z = std::floor(min_z / depth_bucket) * depth_bucket;
+      max_z = std::ceil(max_z / depth_bucket) * depth_bucket;
+      constexpr float depth_margin = 1.f;
+      const glm::mat4 proj = glm::ortho(center_ls.x - half_size, center_ls.x + half_size, center_ls.y - half_size, center_ls.y + half_size,
+        -max_z - depth_margin, -min_z + depth_margin);
+      return proj * light_view;
+    }
+  }
+}
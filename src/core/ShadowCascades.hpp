@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ge/BoundingBox.hpp"
+#include <glm/glm.hpp>
+#include <array>
+
+namespace fury
+{
+  // Cascades of directional light shadow map, each one covers a slice of camera frustum
+  namespace shadow_cascades
+  {
+    constexpr int count = 4;
+    // shadows are not rendered further than this distance from camera
+    constexpr float max_distance = 100.f;
+    // blend between logarithmic and uniform split schemes, 1 is fully logarithmic
+    constexpr float split_lambda = 0.75f;
+    // far distance of each cascade in view space
+    std::array<float, count> compute_splits(float znear, float zfar, float lambda = split_lambda);
+    // world space corners of camera frustum slice
+    std::array<glm::vec3, 8> get_slice_corners(const glm::mat4& view, float fovy_deg, float aspect, float slice_near, float slice_far);
+    // part of slice radius added around the sphere, cascade center may lag behind the slice by this distance
+    constexpr float guard_fraction = 0.125f;
+    // depth range is extended to multiples of this distance
+    constexpr float depth_bucket = 16.f;
+    // light view projection that covers bounding sphere of the slice. light view doesn't depend on camera and
+    // sphere center is snapped to coarse grid of guard margin size (multiple of shadow map texel), so matrix stays
+    // the same while camera moves or turns within the margin. depth range covers scene bbox rounded to depth buckets,
+    // so casters outside of the slice are not clipped and scene changes rarely move it
+    glm::mat4 fit(const std::array<glm::vec3, 8>& slice_corners, const glm::vec3& light_dir, const BoundingBox& scene_bbox, int resolution);
+  }
+}
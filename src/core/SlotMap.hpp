@@ -0,0 +1,79 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <optional>
+#include <cstddef>
+
+namespace fury
+{
+  // Values kept densely packed in a vector and addressed by key, e.g. entity id.
+  // Insert, update and erase are O(1): erase moves the last value into the hole, so dense indices change only there.
+  // Dense storage can be mirrored into a GPU buffer and updated with ranges reported by insert/erase.
+  template<typename Key, typename T>
+  class SlotMap
+  {
+  public:
+    // returns dense index of value
+    size_t insert_or_assign(const Key& key, const T& value)
+    {
+      auto [it, inserted] = m_indices.try_emplace(key, m_values.size());
+      if (inserted)
+      {
+        m_values.push_back(value);
+        m_keys.push_back(key);
+      }
+      else
+      {
+        m_values[it->second] = value;
+      }
+      return it->second;
+    }
+    // returns dense index that got the last value, nothing if erased value was the last one or key isn't present
+    std::optional<size_t> erase(const Key& key)
+    {
+      auto it = m_indices.find(key);
+      if (it == m_indices.end())
+      {
+        return std::nullopt;
+      }
+      const size_t idx = it->second;
+      const size_t last = m_values.size() - 1;
+      m_indices.erase(it);
+      if (idx == last)
+      {
+        m_values.pop_back();
+        m_keys.pop_back();
+        return std::nullopt;
+      }
+      m_values[idx] = std::move(m_values[last]);
+      m_keys[idx] = m_keys[last];
+      m_indices[m_keys[idx]] = idx;
+      m_values.pop_back();
+      m_keys.pop_back();
+      return idx;
+    }
+    bool contains(const Key& key) const { return m_indices.count(key) != 0; }
+    std::optional<size_t> index_of(const Key& key) const
+    {
+      auto it = m_indices.find(key);
+      return it != m_indices.end() ? std::optional<size_t>(it->second) : std::nullopt;
+    }
+    void clear()
+    {
+      m_values.clear();
+      m_keys.clear();
+      m_indices.clear();
+    }
+    size_t size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+    const T* data() const { return m_values.data(); }
+    const std::vector<T>& values() const { return m_values; }
+    // key of value at dense index
+    const Key& key_at(size_t idx) const { return m_keys[idx]; }
+  private:
+    std::vector<T> m_values;
+    std::vector<Key> m_keys;
+    std::unordered_map<Key, size_t> m_indices;
+  };
+}
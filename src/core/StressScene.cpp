@@ -0,0 +1,144 @@
+#include "StressScene.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+  // mt19937 sequence is fixed by the standard, distributions aren't, so floats are made by hand
+  class Random
+  {
+  public:
+    explicit Random(uint32_t seed) : m_engine(seed) {}
+    // [0, 1)
+    float next() { return static_cast<float>(m_engine() >> 8) * (1.f / 16777216.f); }
+    float range(float min, float max) { return min + (max - min) * next(); }
+    uint32_t index(size_t count) { return std::min(static_cast<uint32_t>(next() * count), static_cast<uint32_t>(count - 1)); }
+    glm::vec3 vec3(float min, float max)
+    {
+      // evaluation order of constructor arguments is unspecified
+      const float x = range(min, max);
+      const float y = range(min, max);
+      const float z = range(min, max);
+      return glm::vec3(x, y, z);
+    }
+  private:
+    std::mt19937 m_engine;
+  };
+
+  constexpr float object_spacing = 3.f;
+  // distance of child from its parent
+  constexpr float child_offset = 1.5f;
+}
+
+namespace fury
+{
+  namespace stress_scene
+  {
+    Plan make_plan(const Config& config)
+    {
+      Plan plan;
+      plan.half_extent = std::max(std::cbrt(static_cast<float>(config.object_count)) * object_spacing * 0.5f, 5.f);
+      auto weights = config.kind_weights;
+      if (config.model_files.empty())
+      {
+        weights[static_cast<size_t>(ObjectKind::MODEL)] = 0.f;
+      }
+      float total_weight = 0.f;
+      for (float& weight : weights)
+      {
+        weight = std::max(weight, 0.f);
+        total_weight += weight;
+      }
+      const uint32_t depth = std::max(config.hierarchy_depth, 1u);
+      Random rng(config.seed);
+      plan.objects.resize(config.object_count);
+      for (uint32_t i = 0; i < config.object_count; i++)
+      {
+        ObjectSpec& spec = plan.objects[i];
+        // every value is drawn for every object, so changing one parameter doesn't reshuffle others
+        const float kind_roll = rng.next() * total_weight;
+        const uint32_t texture = config.texture_count > 0 ? rng.index(config.texture_count) : 0;
+        const uint32_t model = config.model_files.empty() ? 0 : rng.index(config.model_files.size());
+        const glm::vec3 root_position = rng.vec3(-plan.half_extent, plan.half_extent);
+        glm::vec3 child_direction = rng.vec3(-1.f, 1.f);
+        const float root_scale = rng.range(0.3f, 1.f);
+        spec.color = glm::vec4(rng.vec3(0.2f, 1.f), 1.f);
+        spec.animated = rng.next() < config.animated_fraction;
+        glm::vec3 axis = rng.vec3(-1.f, 1.f);
+        spec.rotation_speed = rng.range(0.2f, 1.5f);
+        spec.curve_control = rng.vec3(-2.f, 2.f);
+        spec.curve_end = rng.vec3(-2.f, 2.f);
+
+        spec.kind = ObjectKind::CUBE;
+        float cumulative = 0.f;
+        for (size_t kind = 0; kind < weights.size(); kind++)
+        {
+          cumulative += weights[kind];
+          if (weights[kind] > 0.f && kind_roll < cumulative)
+          {
+            spec.kind = static_cast<ObjectKind>(kind);
+            break;
+          }
+        }
+        if (spec.kind == ObjectKind::CUBE && config.texture_count > 0)
+        {
+          spec.variant = static_cast<int32_t>(texture);
+        }
+        else if (spec.kind == ObjectKind::MODEL)
+        {
+          spec.variant = static_cast<int32_t>(model);
+        }
+        if (i % depth == 0)
+        {
+          spec.translation = root_position;
+          spec.scale = root_scale;
+        }
+        else
+        {
+          spec.parent = static_cast<int32_t>(i - 1);
+          if (glm::dot(child_direction, child_direction) < 1e-6f)
+          {
+            child_direction = glm::vec3(1.f, 0.f, 0.f);
+          }
+          spec.translation = glm::normalize(child_direction) * child_offset;
+        }
+        spec.rotation_axis = glm::dot(axis, axis) < 1e-6f ? glm::vec3(0.f, 1.f, 0.f) : glm::normalize(axis);
+      }
+
+      plan.lights.resize(config.light_count);
+      for (LightSpec& light : plan.lights)
+      {
+        light.position = rng.vec3(-plan.half_extent, plan.half_extent);
+        light.color = rng.vec3(0.5f, 1.f);
+      }
+      return plan;
+    }
+
+    std::vector<uint8_t> make_texture_pixels(uint32_t index, int size)
+    {
+      // two colors per texture from index bits, so neighbouring indices differ
+      const uint32_t hash = (index + 1) * 2654435761u;
+      const uint8_t colors[2][3] = {
+        { static_cast<uint8_t>(hash), static_cast<uint8_t>(hash >> 8), static_cast<uint8_t>(hash >> 16) },
+        { static_cast<uint8_t>(~hash >> 4), static_cast<uint8_t>(~hash >> 12), static_cast<uint8_t>(~hash >> 20) }
+      };
+      constexpr int cells = 8;
+      const int cell_size = std::max(size / cells, 1);
+      std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+      for (int y = 0; y < size; y++)
+      {
+        for (int x = 0; x < size; x++)
+        {
+          const uint8_t* color = colors[(x / cell_size + y / cell_size) % 2];
+          uint8_t* pixel = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+          pixel[0] = color[0];
+          pixel[1] = color[1];
+          pixel[2] = color[2];
+          pixel[3] = 255;
+        }
+      }
+      return pixels;
+    }
+  }
+}
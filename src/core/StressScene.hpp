@@ -0,0 +1,80 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace fury
+{
+  // Seeded scene of many generated objects for measuring the engine at production scale. Plan is deterministic:
+  // same config gives the same objects on every platform, so runs of different commits are comparable
+  namespace stress_scene
+  {
+    enum class ObjectKind : uint8_t
+    {
+      CUBE,
+      ICOSAHEDRON,
+      CURVE,
+      MODEL,
+      COUNT
+    };
+
+    struct Config
+    {
+      uint32_t seed = 1;
+      uint32_t object_count = 10000;
+      // objects are linked into chains of this many nodes, each node is transformed relative to previous one
+      uint32_t hierarchy_depth = 1;
+      // share of objects with rotation controller
+      float animated_fraction = 0.f;
+      // point lights on top of default ones
+      uint32_t light_count = 0;
+      // generated textures spread over cubes, 0 keeps cubes untextured
+      uint32_t texture_count = 0;
+      // imported once, instances share meshes
+      std::vector<std::string> model_files;
+      // relative frequency of object kinds, model weight is ignored without model files
+      std::array<float, static_cast<size_t>(ObjectKind::COUNT)> kind_weights = { 0.6f, 0.25f, 0.05f, 0.1f };
+    };
+
+    struct ObjectSpec
+    {
+      ObjectKind kind = ObjectKind::CUBE;
+      // texture of cube or model file index, -1 if none
+      int32_t variant = -1;
+      // index of parent object, -1 for roots
+      int32_t parent = -1;
+      glm::vec3 translation = glm::vec3(0.f);
+      float scale = 1.f;
+      glm::vec4 color = glm::vec4(1.f);
+      bool animated = false;
+      glm::vec3 rotation_axis = glm::vec3(0.f, 1.f, 0.f);
+      // radians per second
+      float rotation_speed = 0.f;
+      // control point of quadratic curve, relative to its start
+      glm::vec3 curve_control = glm::vec3(0.f);
+      glm::vec3 curve_end = glm::vec3(0.f);
+    };
+
+    struct LightSpec
+    {
+      glm::vec3 position = glm::vec3(0.f);
+      glm::vec3 color = glm::vec3(1.f);
+    };
+
+    struct Plan
+    {
+      // parents always precede their children
+      std::vector<ObjectSpec> objects;
+      std::vector<LightSpec> lights;
+      // roots are placed in cube [-half_extent, half_extent]
+      float half_extent = 0.f;
+    };
+
+    Plan make_plan(const Config& config);
+    // RGBA8 checker of size x size pixels, its colors depend on index
+    std::vector<uint8_t> make_texture_pixels(uint32_t index, int size);
+  }
+}
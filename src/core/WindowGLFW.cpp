@@ -3,6 +3,26 @@
 #include "input/InputSystem.hpp"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+  bool has_extension(const char* name)
+  {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+      const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+      if (ext && std::strcmp(ext, name) == 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+} // namespace
 
 namespace fury
 {
@@ -19,7 +39,7 @@ namespace fury
     init(width, height, title);
   }
 
-  void WindowGLFW::init(int width, int height, const char* title)
+  void WindowGLFW::init(int width, int height, const char* title, LaunchOptions::HeadlessContext headless)
   {
     m_width = width;
     m_height = height;
@@ -30,6 +50,12 @@ namespace fury
     // Tell GLFW we are using the CORE profile (only modern functions)
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_SAMPLES, 4);
+    if (headless != LaunchOptions::HeadlessContext::NONE)
+    {
+      glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+      glfwWindowHint(GLFW_CONTEXT_CREATION_API,
+        headless == LaunchOptions::HeadlessContext::EGL ? GLFW_EGL_CONTEXT_API : GLFW_OSMESA_CONTEXT_API);
+    }
     m_window = glfwCreateWindow(width, height, title, nullptr, glfwGetCurrentContext());
     if (m_window == nullptr)
     {
@@ -58,7 +84,14 @@ namespace fury
     glfwSetWindowSizeCallback(m_window, window_size_change_callback);
     glfwSetWindowFocusCallback(m_window, window_focus_change_callback);
     glfwSetCursorEnterCallback(m_window, window_cursor_enter_callback);
-    gladLoadGL();
+    // functions come from context api, it isn't libGL in headless mode
+    gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+    // geometry, shadow, normals and picking shaders read gl_BaseInstanceARB / gl_DrawIDARB
+    if (!::has_extension("GL_ARB_shader_draw_parameters"))
+    {
+      Logger::critical("Driver doesn't support GL_ARB_shader_draw_parameters which is required by the renderer");
+      throw std::runtime_error("GL_ARB_shader_draw_parameters is not supported");
+    }
     glViewport(0, 0, m_width, m_height);
   }
 
@@ -2,6 +2,7 @@
 
 #include "Macros.hpp"
 #include "Event.hpp"
+#include "LaunchOptions.hpp"
 
 struct GLFWwindow;
 
@@ -15,7 +16,8 @@ namespace fury
     WindowGLFW() = default;
     WindowGLFW(int width, int height, const char* title);
     ~WindowGLFW();
-    void init(int width, int height, const char* title);
+    // headless window is hidden and has context of given api
+    void init(int width, int height, const char* title, LaunchOptions::HeadlessContext headless = LaunchOptions::HeadlessContext::NONE);
     GLFWwindow* gl_window() const { return m_window; }
     void set_width(int w) { m_width = w; }
     void set_height(int h) { m_height = h; }
@@ -27,6 +27,7 @@ namespace fury
     { GLFW_KEY_ESCAPE, InputCode::FURY_KEY_ESC },
     { GLFW_KEY_GRAVE_ACCENT, InputCode::FURY_KEY_GRAVE_ACCENT },
     { GLFW_KEY_BACKSPACE, InputCode::FURY_KEY_BACKSPACE },
+    { GLFW_KEY_F9, InputCode::FURY_KEY_F9 },
 
     { GLFW_MOUSE_BUTTON_1, InputCode::FURY_MOUSE_BUTTON_LEFT },
     { GLFW_MOUSE_BUTTON_2, InputCode::FURY_MOUSE_BUTTON_RIGHT },
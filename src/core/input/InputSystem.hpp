@@ -46,6 +46,7 @@ namespace fury
     FURY_KEY_ESC,
     FURY_KEY_GRAVE_ACCENT,
     FURY_KEY_BACKSPACE,
+    FURY_KEY_F9,
     FURY_KEY_INPUTS_END,
 
     FURY_MOUSE_INPUTS_BEGIN,
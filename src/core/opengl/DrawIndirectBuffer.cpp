@@ -0,0 +1,12 @@
+#include "DrawIndirectBuffer.hpp"
+
+namespace fury
+{
+	DrawIndirectBuffer::DrawIndirectBuffer() : OpenGLBuffer(GL_DRAW_INDIRECT_BUFFER)
+	{
+	}
+
+	DrawIndirectBuffer::DrawIndirectBuffer(size_t size) : OpenGLBuffer(GL_DRAW_INDIRECT_BUFFER, size)
+	{
+	}
+}
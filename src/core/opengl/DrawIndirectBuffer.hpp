@@ -0,0 +1,13 @@
+#pragma once
+
+#include "OpenGLBuffer.hpp"
+
+namespace fury
+{
+	class DrawIndirectBuffer : public OpenGLBuffer
+	{
+	public:
+		DrawIndirectBuffer();
+		DrawIndirectBuffer(size_t size);
+	};
+}
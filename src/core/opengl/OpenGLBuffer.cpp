@@ -1,4 +1,5 @@
 #include "OpenGLBuffer.hpp"
+#include "UploadStats.hpp"
 #include "core/Logger.hpp"
 
 namespace fury
@@ -22,6 +23,7 @@ namespace fury
       return;
     }
     glBufferSubData(m_type, offset, size_in_bytes, data);
+    UploadStats::add(size_in_bytes);
   }
 
 
@@ -37,6 +39,46 @@ namespace fury
       resize(new_size);
   }
 
+  void OpenGLBuffer::grow(size_t new_size)
+  {
+    if (new_size <= m_size)
+    {
+      return;
+    }
+    // use copy targets to not break bindings of m_type target (e.g. element buffer of bound vao)
+    glBindBuffer(GL_COPY_READ_BUFFER, m_id);
+    if (m_size == 0)
+    {
+      glBufferData(GL_COPY_READ_BUFFER, new_size, nullptr, GL_STATIC_DRAW);
+    }
+    else
+    {
+      GLuint tmp = 0;
+      glGenBuffers(1, &tmp);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, tmp);
+      glBufferData(GL_COPY_WRITE_BUFFER, m_size, nullptr, GL_STREAM_COPY);
+      glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, m_size);
+      glBufferData(GL_COPY_READ_BUFFER, new_size, nullptr, GL_STATIC_DRAW);
+      glCopyBufferSubData(GL_COPY_WRITE_BUFFER, GL_COPY_READ_BUFFER, 0, 0, m_size);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+      glDeleteBuffers(1, &tmp);
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    m_size = new_size;
+  }
+
+  void OpenGLBuffer::copy_data(size_t src_offset, size_t dst_offset, size_t size_in_bytes)
+  {
+    if (src_offset + size_in_bytes > m_size || dst_offset + size_in_bytes > m_size)
+    {
+      Logger::error("Could not copy buffer data. Allocated size {}, trying to copy {} from {} to {}.", m_size, size_in_bytes, src_offset, dst_offset);
+      return;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, m_id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_READ_BUFFER, src_offset, dst_offset, size_in_bytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  }
+
   void OpenGLBuffer::bind() const
   {
     glBindBuffer(m_type, m_id);
@@ -14,7 +14,11 @@ namespace fury
     ~OpenGLBuffer();
     void resize(size_t new_size);
     void resize_if_smaller(size_t new_size);
+    // resize with keeping current content. buffer doesn't have to be bound
+    void grow(size_t new_size);
     void set_data(const void* data, size_t size_in_bytes, size_t offset);
+    // copy within buffer, ranges must not overlap. buffer doesn't have to be bound
+    void copy_data(size_t src_offset, size_t dst_offset, size_t size_in_bytes);
     void bind() const override;
     void unbind() const override;
     size_t get_size() const { return m_size; }
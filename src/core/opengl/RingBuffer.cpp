@@ -0,0 +1,144 @@
+#include "RingBuffer.hpp"
+#include "UploadStats.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace fury
+{
+  RingBuffer::RingBuffer(GLenum type, bool readable) : m_type(type), m_readable(readable)
+  {
+    GLint alignment = 0;
+    if (type == GL_UNIFORM_BUFFER)
+    {
+      glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+    else if (type == GL_SHADER_STORAGE_BUFFER)
+    {
+      glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+    m_default_alignment = std::max<size_t>(alignment, 16);
+  }
+
+  RingBuffer::~RingBuffer()
+  {
+    if (m_id != 0)
+    {
+      glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+      glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+      glDeleteBuffers(1, id_ref());
+    }
+  }
+
+  void RingBuffer::begin_frame()
+  {
+    s_frame++;
+    GLsync& fence = s_fences[s_frame % frames_in_flight];
+    if (!fence)
+    {
+      return;
+    }
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+      s_stall_count++;
+      while (status == GL_TIMEOUT_EXPIRED)
+      {
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+      }
+    }
+    if (status == GL_WAIT_FAILED)
+    {
+      Logger::error("RingBuffer: glClientWaitSync failed.");
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  void RingBuffer::end_frame()
+  {
+    GLsync& fence = s_fences[s_frame % frames_in_flight];
+    if (fence)
+    {
+      glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+
+  RingBuffer::Allocation RingBuffer::allocate(size_t size, size_t alignment)
+  {
+    if (alignment == 0)
+    {
+      alignment = m_default_alignment;
+    }
+    if (m_frame != s_frame)
+    {
+      m_frame = s_frame;
+      m_head = 0;
+    }
+    const size_t region_offset = (s_frame % frames_in_flight) * m_region_size;
+    // alignment is applied to offset from buffer start, it doesn't have to be power of 2 (e.g. vertex size)
+    size_t offset = (region_offset + m_head + alignment - 1) / alignment * alignment;
+    if (m_id == 0 || offset + size > region_offset + m_region_size)
+    {
+      recreate(std::max(m_region_size * 2, (m_head + size + alignment) * 2));
+      return allocate(size, alignment);
+    }
+    m_head = offset + size - region_offset;
+    if (!m_readable)
+    {
+      UploadStats::add(size);
+    }
+    return { m_mapped + offset, offset };
+  }
+
+  RingBuffer::Allocation RingBuffer::push(const void* data, size_t size, size_t alignment)
+  {
+    Allocation allocation = allocate(size, alignment);
+    std::memcpy(allocation.ptr, data, size);
+    return allocation;
+  }
+
+  void RingBuffer::recreate(size_t region_size)
+  {
+    if (m_id != 0)
+    {
+      // GPU may still use old storage, OpenGL deletes it when it's not used anymore
+      glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+      glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+      glDeleteBuffers(1, id_ref());
+    }
+    m_region_size = region_size;
+    m_head = 0;
+    m_generation++;
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | (m_readable ? GL_MAP_READ_BIT : 0);
+    const size_t total_size = m_region_size * frames_in_flight;
+    // copy target is used to not touch bindings of m_type target
+    glGenBuffers(1, id_ref());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, total_size, nullptr, flags);
+    m_mapped = static_cast<std::byte*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, total_size, flags));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (!m_mapped)
+    {
+      Logger::error("RingBuffer: failed to map buffer of size {}.", total_size);
+    }
+  }
+
+  void RingBuffer::bind_range(GLuint binding_point, size_t offset, size_t size) const
+  {
+    glBindBufferRange(m_type, binding_point, m_id, offset, size);
+  }
+
+  void RingBuffer::bind() const
+  {
+    glBindBuffer(m_type, m_id);
+  }
+
+  void RingBuffer::unbind() const
+  {
+    glBindBuffer(m_type, 0);
+  }
+}
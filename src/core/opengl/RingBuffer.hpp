@@ -0,0 +1,63 @@
+#pragma once
+
+#include "OpenGLObject.hpp"
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace fury
+{
+  // Persistently and coherently mapped buffer for data that is rewritten every frame.
+  // Buffer is split into frames_in_flight regions, each frame sub-allocates from its own region, so CPU never
+  // writes memory that GPU may still read. Region is reused only after fence of the frame that used it is signaled.
+  class RingBuffer : public OpenGLObject
+  {
+  public:
+    constexpr static int frames_in_flight = 3;
+    struct Allocation
+    {
+      void* ptr = nullptr;
+      // from the beginning of the buffer
+      size_t offset = 0;
+    };
+    FURY_OnlyMovable(RingBuffer)
+    // readable buffer is mapped with read access too, e.g. to read back GPU results after the frame fence
+    RingBuffer(GLenum type, bool readable = false);
+    ~RingBuffer();
+    // wait until GPU finished the frame that used the same regions. call once at the beginning of the frame
+    static void begin_frame();
+    // fence all commands of current frame. call once at the end of the frame
+    static void end_frame();
+    // number of begin_frame() calls that had to wait for GPU
+    static uint32_t get_stall_count() { return s_stall_count; }
+    // index of region used by current frame. data written to a region by GPU is complete when same slot comes again
+    static int get_frame_slot() { return static_cast<int>(s_frame % frames_in_flight); }
+    // alignment 0 means default for buffer type (e.g. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT).
+    // if region is full, buffer is recreated with bigger storage, so id can change and earlier allocations of this frame become invalid
+    Allocation allocate(size_t size, size_t alignment = 0);
+    Allocation push(const void* data, size_t size, size_t alignment = 0);
+    void bind_range(GLuint binding_point, size_t offset, size_t size) const;
+    void bind() const override;
+    void unbind() const override;
+    size_t get_region_size() const { return m_region_size; }
+    const void* get_mapped(size_t offset) const { return m_mapped + offset; }
+    // changes every time storage is recreated. unlike id, which GL may hand out again, it identifies the storage
+    uint64_t get_generation() const { return m_generation; }
+  private:
+    void recreate(size_t region_size);
+  private:
+    inline static std::array<GLsync, frames_in_flight> s_fences = {};
+    inline static uint64_t s_frame = 0;
+    inline static uint32_t s_stall_count = 0;
+    std::byte* m_mapped = nullptr;
+    size_t m_region_size = 0;
+    size_t m_default_alignment = 16;
+    // offset within current region
+    size_t m_head = 0;
+    uint64_t m_frame = 0;
+    uint64_t m_generation = 0;
+    GLenum m_type;
+    bool m_readable = false;
+  };
+}
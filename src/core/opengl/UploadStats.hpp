@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace fury
+{
+  // bytes written by CPU into buffer storage: OpenGLBuffer::set_data and allocations of write-only ring buffers
+  class UploadStats
+  {
+  public:
+    static void add(size_t bytes) { s_bytes += bytes; }
+    // bytes counted since previous call
+    static size_t take() { return std::exchange(s_bytes, 0); }
+  private:
+    inline static size_t s_bytes = 0;
+  };
+}
@@ -7,10 +7,10 @@ namespace fury
     glGenVertexArrays(1, id_ref());
   }
 
-  void VertexArrayObject::link_attrib(GLuint layout, GLuint num_components, GLenum type, GLsizei stride, void* offset)
+  void VertexArrayObject::link_attrib(GLuint layout, GLuint num_components, GLenum type, GLsizei stride, void* offset, bool normalized)
   {
     // Configure the Vertex Attribute so that OpenGL knows how to read the VBO
-    glVertexAttribPointer(layout, num_components, type, GL_FALSE, stride, offset);
+    glVertexAttribPointer(layout, num_components, type, normalized ? GL_TRUE : GL_FALSE, stride, offset);
     // Enable the Vertex Attribute so that OpenGL knows to use it
     glEnableVertexAttribArray(layout);
   }
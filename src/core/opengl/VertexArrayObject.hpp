@@ -9,7 +9,7 @@ namespace fury
   public:
     VertexArrayObject();
     ~VertexArrayObject();
-    void link_attrib(GLuint layout, GLuint num_components, GLenum type, GLsizei stride, void* offset);
+    void link_attrib(GLuint layout, GLuint num_components, GLenum type, GLsizei stride, void* offset, bool normalized = false);
     void bind() const override;
     void unbind() const override;
   };
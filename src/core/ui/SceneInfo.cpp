@@ -9,6 +9,7 @@
 #include "core/RotationController.hpp"
 #include "core/SceneGraphManager.hpp"
 #include "core/Globals.hpp"
+#include "core/GpuTimers.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -79,10 +80,17 @@ namespace fury
       {
         on_show_scene_bbox.notify(m_show_scene_bbox);
       }
+      // g-buffer isn't multisampled
+      ImGui::BeginDisabled(m_use_deferred_shading);
       if (ImGui::Checkbox("Use MSAA", &m_use_msaa))
       {
         msaa_button_click.notify(m_use_msaa);
       }
+      ImGui::EndDisabled();
+      if (ImGui::Checkbox("Deferred shading", &m_use_deferred_shading))
+      {
+        deferred_shading_button_click.notify(m_use_deferred_shading);
+      }
       if (ImGui::Checkbox("Show grid", &m_show_grid))
       {
       }
@@ -90,6 +98,21 @@ namespace fury
       {
         on_frustum_culling_toggled.notify(m_frustum_culling_enabled);
       }
+      if (ImGui::Checkbox("Indirect rendering", &m_indirect_rendering_enabled))
+      {
+      }
+      // culls batched draws only, so it needs indirect rendering
+      ImGui::BeginDisabled(!m_indirect_rendering_enabled);
+      if (ImGui::Checkbox("GPU culling", &m_gpu_culling_enabled))
+      {
+      }
+      ImGui::EndDisabled();
+      if (ImGui::Checkbox("Mesh LODs", &m_lod_enabled))
+      {
+      }
+      if (ImGui::Checkbox("Packed vertices", &m_packed_vertices_enabled))
+      {
+      }
       if (ImGui::Checkbox("VSync", &m_use_vsync))
       {
         if (m_use_vsync)
@@ -158,11 +181,32 @@ namespace fury
       ImGui::Text(fmt::format("{} objects culled", m_num_culled_objects).c_str());
     }
 
+    ImGui::Separator();
+    ImGui::Text(fmt::format("Draw calls {} ({} without batching)", m_draw_calls, m_draw_calls_unbatched).c_str());
+    ImGui::Text(fmt::format("State changes {} (saved {} by sorting)", m_state_changes,
+      m_state_changes_unsorted > m_state_changes ? m_state_changes_unsorted - m_state_changes : 0).c_str());
+
     ImGuiIO& io = ImGui::GetIO();
     ImGui::Separator();
     const RenderInfo& info = m_scene->get_render_info();
     ImGui::Text("Frame time %.3f ms", info.frame_time * 1000.f);
     ImGui::Text("FPS %d", info.fps);
+    ImGui::Text("Uploaded %.1f KB", info.upload_bytes / 1024.f);
+    if (ImGui::CollapsingHeader("GPU timings"))
+    {
+      float total = 0.f;
+      for (const GpuTimers::Section& section : GpuTimers::instance().get_sections())
+      {
+        ImGui::Text("%-18s %7.3f avg %7.3f max ms", section.name().c_str(), section.average(), section.max());
+        total += section.average();
+      }
+      ImGui::Text("%-18s %7.3f avg ms", "Total", total);
+    }
+    if (info.target_frame_time > 0.f)
+    {
+      ImGui::Text("Frame pacing %.3f / %.3f ms, jitter %.3f ms", info.achieved_frame_time * 1000.f,
+        info.target_frame_time * 1000.f, info.frame_time_jitter * 1000.f);
+    }
     ImGui::End();
 
     ImGui::Render();
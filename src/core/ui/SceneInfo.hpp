@@ -17,7 +17,13 @@ namespace fury
 		SceneInfo(Scene* scene, MenuBar* menubar);
 		bool is_grid_visible() const { return m_show_grid; }
 		bool is_frustum_culling_enabled() const { return m_frustum_culling_enabled; }
+		bool is_indirect_rendering_enabled() const { return m_indirect_rendering_enabled; }
+		bool is_gpu_culling_enabled() const { return m_gpu_culling_enabled; }
+		bool is_lod_enabled() const { return m_lod_enabled; }
+		bool is_packed_vertices_enabled() const { return m_packed_vertices_enabled; }
 		void set_num_culled_objects(uint32_t val) { m_num_culled_objects = val; }
+		void set_draw_calls(uint32_t issued, uint32_t unbatched) { m_draw_calls = issued; m_draw_calls_unbatched = unbatched; }
+		void set_state_changes(uint32_t sorted, uint32_t unsorted) { m_state_changes = sorted; m_state_changes_unsorted = unsorted; }
 		void tick(float) override;
 		Event<Object3D*, bool> on_visible_normals_button_pressed;
 		Event<Object3D*, bool> on_visible_bbox_button_pressed;
@@ -25,6 +31,7 @@ namespace fury
 		Event<int> on_polygon_mode_change;
 		Event<bool> on_show_scene_bbox;
 		Event<bool> msaa_button_click;
+		Event<bool> deferred_shading_button_click;
 		Event<bool> on_frustum_culling_toggled;
 	private:
 		void render_object_properties(Object3D& drawable);
@@ -37,12 +44,21 @@ namespace fury
 		MenuBar* m_menubar = nullptr;
 		int m_fps_cap = 0;
 		uint32_t m_num_culled_objects = 0;
+		uint32_t m_draw_calls = 0;
+		uint32_t m_draw_calls_unbatched = 0;
+		uint32_t m_state_changes = 0;
+		uint32_t m_state_changes_unsorted = 0;
 		uint16_t m_guizmo_operation;
 		bool m_fill_polygons = true;
 		bool m_show_scene_bbox = false;
 		bool m_use_msaa = true;
+		bool m_use_deferred_shading = false;
 		bool m_use_vsync = true;
 		bool m_show_grid = false;
 		bool m_frustum_culling_enabled = true;
+		bool m_indirect_rendering_enabled = true;
+		bool m_gpu_culling_enabled = false;
+		bool m_lod_enabled = true;
+		bool m_packed_vertices_enabled = true;
 	};
 }
\ No newline at end of file
@@ -31,7 +31,6 @@ namespace fury
         Vertex res = ((1 - t) * (1 - t) * m_start_pnt.position) +
           (2 * t * (1 - t) * m_control_points[0].position) +
           (t * t * m_end_pnt.position);
-        res.color = m_color;
         vertices.push_back(res);
       }
     }
@@ -54,7 +53,6 @@ namespace fury
           (3 * std::pow((1 - t), 2.f) * t * P1) +
           (3 * (1 - t) * t * t * P2) +
           (std::pow(t, 3.f) * P3);
-        res.color = m_color;
         vertices.push_back(res);
       }
     }
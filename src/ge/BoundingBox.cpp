@@ -42,6 +42,15 @@ namespace fury
       (point.z >= m_min.z && point.z <= m_max.z);
   }
 
+  BoundingBox BoundingBox::transformed(const glm::mat4& transform) const
+  {
+    const glm::vec3 extents = (m_max - m_min) * 0.5f;
+    const glm::mat3 mm = { glm::abs(transform[0]), glm::abs(transform[1]), glm::abs(transform[2]) };
+    const glm::vec3 center_world = transform * glm::vec4(center(), 1);
+    const glm::vec3 extents_world = mm * extents;
+    return BoundingBox(center_world - extents_world, center_world + extents_world);
+  }
+
   void BoundingBox::init(const glm::vec3& min, const glm::vec3& max)
   {
     m_min = min;
@@ -16,6 +16,8 @@ namespace fury
     std::array<glm::vec3, 8> get_points() const;
     bool is_empty() const;
     bool contains(const glm::vec3& point) const;
+    // AABB of box after transform, approximated (bigger than tight one) if transform has rotation
+    BoundingBox transformed(const glm::mat4& transform) const;
     glm::vec3& min() { return m_min; }
     glm::vec3& max() { return m_max; }
     glm::vec3 center() const { return (m_min + m_max) * 0.5f; }
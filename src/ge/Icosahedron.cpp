@@ -68,7 +68,6 @@ namespace fury
     Vertex ab((a.position + b.position) / 2.f);
     Vertex bc((b.position + c.position) / 2.f);
     Vertex ac((a.position + c.position) / 2.f);
-    ab.color = bc.color = ac.color = m_color;
     // ORDER IS IMPORTANT !!! 
     subdivide_triangles(subdivision_level - 1, a, ab, ac);
     subdivide_triangles(subdivision_level - 1, b, bc, ab);
@@ -1,4 +1,5 @@
 #include "Mesh.hpp"
+#include "MeshLod.hpp"
 
 namespace fury
 {
@@ -42,4 +43,32 @@ namespace fury
     }
     return m_faces_indices;
   }
+
+  void Mesh::generate_lods()
+  {
+    m_lods.clear();
+    const std::vector<GLuint>& indices = faces_as_indices();
+    if (indices.size() / 3 < mesh_lod::min_triangles)
+    {
+      return;
+    }
+    std::vector<glm::vec3> positions;
+    positions.reserve(m_vertices.size());
+    for (const Vertex& vertex : m_vertices)
+    {
+      positions.push_back(vertex.position);
+    }
+    // each level is simplified from previous one
+    for (uint32_t lod = 1; lod < mesh_lod::max_lods; lod++)
+    {
+      const std::vector<GLuint>& source = lod == 1 ? indices : m_lods.back();
+      std::vector<GLuint> lod_indices = mesh_lod::simplify(positions, source, source.size() / 2);
+      // not worth a level if simplifier got stuck
+      if (lod_indices.empty() || lod_indices.size() > source.size() * 3 / 4)
+      {
+        break;
+      }
+      m_lods.push_back(std::move(lod_indices));
+    }
+  }
 }
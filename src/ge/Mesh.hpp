@@ -25,6 +25,11 @@ namespace fury
     std::vector<Face>& faces() { return m_faces; }
     const std::vector<Face>& faces() const { return m_faces; }
     const std::vector<GLuint>& faces_as_indices() const;
+    // simplified index buffers over the same vertices, generated for big meshes only
+    void generate_lods();
+    size_t lod_count() const { return m_lods.size() + 1; }
+    // level 0 is the mesh itself
+    const std::vector<GLuint>& lod_indices(size_t lod) const { return lod == 0 ? faces_as_indices() : m_lods[lod - 1]; }
     void set_texture(const std::shared_ptr<Texture2D>& tex, TextureType type) { m_textures[static_cast<int>(type)] = tex; }
     const std::shared_ptr<Texture2D> get_texture(TextureType type) const { return m_textures[static_cast<int>(type)]; }
     BoundingBox& bbox() { return m_bbox; }
@@ -48,6 +53,7 @@ namespace fury
     std::vector<Vertex> m_vertices;
     std::vector<Face> m_faces;
     mutable std::vector<GLuint> m_faces_indices;
+    std::vector<std::vector<GLuint>> m_lods;
     std::array<std::shared_ptr<Texture2D>, static_cast<int>(TextureType::LAST) + 1> m_textures;
     BoundingBox m_bbox;
   };
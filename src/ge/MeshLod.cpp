@@ -0,0 +1,328 @@
+#include "MeshLod.hpp"
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // symmetric 4x4 matrix of plane equations, error of point is sum of squared distances to planes
+  struct Quadric
+  {
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+
+    Quadric() = default;
+    Quadric(const glm::dvec3& n, double d, double weight)
+    {
+      a00 = n.x * n.x * weight; a01 = n.x * n.y * weight; a02 = n.x * n.z * weight;
+      a11 = n.y * n.y * weight; a12 = n.y * n.z * weight; a22 = n.z * n.z * weight;
+      b0 = n.x * d * weight; b1 = n.y * d * weight; b2 = n.z * d * weight;
+      c = d * d * weight;
+    }
+
+    Quadric& operator+=(const Quadric& other)
+    {
+      a00 += other.a00; a01 += other.a01; a02 += other.a02;
+      a11 += other.a11; a12 += other.a12; a22 += other.a22;
+      b0 += other.b0; b1 += other.b1; b2 += other.b2;
+      c += other.c;
+      return *this;
+    }
+
+    double error(const glm::dvec3& p) const
+    {
+      const double x = p.x, y = p.y, z = p.z;
+      const double e = a00 * x * x + a11 * y * y + a22 * z * z + 2 * (a01 * x * y + a02 * x * z + a12 * y * z)
+        + 2 * (b0 * x + b1 * y + b2 * z) + c;
+      return std::abs(e);
+    }
+  };
+
+  struct Collapse
+  {
+    GLuint from = 0;
+    GLuint to = 0;
+    double cost = 0;
+  };
+
+  // borders are kept in place, otherwise holes of open meshes grow
+  constexpr double border_weight = 10.0;
+
+  glm::dvec3 triangle_normal(const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c)
+  {
+    return glm::cross(b - a, c - a);
+  }
+}
+
+namespace fury
+{
+  namespace mesh_lod
+  {
+    std::vector<GLuint> simplify(const std::vector<glm::vec3>& positions, const std::vector<GLuint>& indices, size_t target_index_count)
+    {
+      // weld vertices by position, first vertex of each position is its representative
+      const size_t vertex_count = positions.size();
+      std::vector<GLuint> weld(vertex_count);
+      std::map<std::tuple<float, float, float>, GLuint> unique_positions;
+      for (GLuint v = 0; v < vertex_count; v++)
+      {
+        const glm::vec3& p = positions[v];
+        weld[v] = unique_positions.try_emplace(std::make_tuple(p.x, p.y, p.z), v).first->second;
+      }
+      std::vector<glm::dvec3> points(vertex_count);
+      for (size_t v = 0; v < vertex_count; v++)
+      {
+        points[v] = glm::dvec3(positions[v]);
+      }
+
+      // triangles over welded vertices and original corners, which are needed for output
+      std::vector<GLuint> triangles;
+      std::vector<GLuint> corners;
+      triangles.reserve(indices.size());
+      corners.reserve(indices.size());
+      for (size_t i = 0; i + 2 < indices.size(); i += 3)
+      {
+        const GLuint a = weld[indices[i]], b = weld[indices[i + 1]], c = weld[indices[i + 2]];
+        if (a == b || b == c || a == c)
+        {
+          continue;
+        }
+        triangles.insert(triangles.end(), { a, b, c });
+        corners.insert(corners.end(), { indices[i], indices[i + 1], indices[i + 2] });
+      }
+
+      std::vector<Quadric> quadrics(vertex_count);
+      std::map<std::pair<GLuint, GLuint>, int> directed_edges;
+      for (size_t i = 0; i < triangles.size(); i += 3)
+      {
+        const GLuint t[3] = { triangles[i], triangles[i + 1], triangles[i + 2] };
+        const glm::dvec3 n = ::triangle_normal(points[t[0]], points[t[1]], points[t[2]]);
+        const double len = glm::length(n);
+        if (len == 0.0)
+        {
+          continue;
+        }
+        const glm::dvec3 unit_n = n / len;
+        const Quadric q(unit_n, -glm::dot(unit_n, points[t[0]]), len * 0.5);
+        for (int k = 0; k < 3; k++)
+        {
+          quadrics[t[k]] += q;
+          directed_edges[{ t[k], t[(k + 1) % 3] }]++;
+        }
+      }
+      // edge used by single triangle is a border, plane through it perpendicular to triangle holds it in place
+      for (size_t i = 0; i < triangles.size(); i += 3)
+      {
+        const GLuint t[3] = { triangles[i], triangles[i + 1], triangles[i + 2] };
+        const glm::dvec3 n = ::triangle_normal(points[t[0]], points[t[1]], points[t[2]]);
+        for (int k = 0; k < 3; k++)
+        {
+          const GLuint u = t[k], v = t[(k + 1) % 3];
+          if (directed_edges.contains({ v, u }))
+          {
+            continue;
+          }
+          const glm::dvec3 edge = points[v] - points[u];
+          const glm::dvec3 border_n = glm::cross(edge, n);
+          const double len = glm::length(border_n);
+          if (len == 0.0)
+          {
+            continue;
+          }
+          const glm::dvec3 unit_n = border_n / len;
+          const Quadric q(unit_n, -glm::dot(unit_n, points[u]), glm::dot(edge, edge) * ::border_weight);
+          quadrics[u] += q;
+          quadrics[v] += q;
+        }
+      }
+
+      target_index_count -= target_index_count % 3;
+      std::vector<GLuint> remap(vertex_count);
+      std::vector<uint8_t> locked(vertex_count);
+      std::vector<size_t> adjacency_offsets(vertex_count + 1);
+      std::vector<size_t> adjacency;
+      std::vector<Collapse> collapses;
+      while (triangles.size() > target_index_count)
+      {
+        // vertex to triangles adjacency
+        std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+        for (GLuint v : triangles)
+        {
+          adjacency_offsets[v + 1]++;
+        }
+        for (size_t v = 0; v < vertex_count; v++)
+        {
+          adjacency_offsets[v + 1] += adjacency_offsets[v];
+        }
+        adjacency.resize(triangles.size());
+        std::vector<size_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+          adjacency[fill[triangles[i]]++] = i / 3;
+        }
+
+        // cheapest direction of each edge
+        collapses.clear();
+        for (size_t i = 0; i < triangles.size(); i += 3)
+        {
+          for (int k = 0; k < 3; k++)
+          {
+            const GLuint u = triangles[i + k], v = triangles[i + (k + 1) % 3];
+            // shared edges are visited from both triangles, take them once
+            if (u > v && directed_edges.contains({ v, u }))
+            {
+              continue;
+            }
+            Quadric q = quadrics[u];
+            q += quadrics[v];
+            const double cost_uv = q.error(points[v]);
+            const double cost_vu = q.error(points[u]);
+            collapses.push_back(cost_uv <= cost_vu ? Collapse{ u, v, cost_uv } : Collapse{ v, u, cost_vu });
+          }
+        }
+        if (collapses.empty())
+        {
+          break;
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+        for (GLuint v = 0; v < vertex_count; v++)
+        {
+          remap[v] = v;
+        }
+        std::fill(locked.begin(), locked.end(), 0);
+        const size_t triangles_to_remove = (triangles.size() - target_index_count) / 3;
+        // collapse usually removes 2 triangles. costs above the goal are left for next passes,
+        // where they are compared with cheaper collapses that were locked in this one
+        const size_t goal = std::min(collapses.size(), std::max<size_t>(triangles_to_remove / 2, 1)) - 1;
+        const double cost_limit = collapses[goal].cost * 1.5;
+        size_t removed = 0;
+        for (const Collapse& collapse : collapses)
+        {
+          if (removed >= triangles_to_remove || collapse.cost > cost_limit)
+          {
+            break;
+          }
+          const GLuint from = collapse.from, to = collapse.to;
+          if (locked[from] || locked[to])
+          {
+            continue;
+          }
+          // triangles around collapsed vertex must not flip
+          bool flips = false;
+          size_t collapsed_triangles = 0;
+          for (size_t a = adjacency_offsets[from]; a < adjacency_offsets[from + 1] && !flips; a++)
+          {
+            const size_t t = adjacency[a] * 3;
+            const GLuint tri[3] = { triangles[t], triangles[t + 1], triangles[t + 2] };
+            if (tri[0] == to || tri[1] == to || tri[2] == to)
+            {
+              collapsed_triangles++;
+              continue;
+            }
+            glm::dvec3 moved[3];
+            for (int k = 0; k < 3; k++)
+            {
+              moved[k] = points[tri[k] == from ? to : tri[k]];
+            }
+            const glm::dvec3 before = ::triangle_normal(points[tri[0]], points[tri[1]], points[tri[2]]);
+            const glm::dvec3 after = ::triangle_normal(moved[0], moved[1], moved[2]);
+            flips = glm::dot(before, after) <= 0.0;
+          }
+          if (flips)
+          {
+            continue;
+          }
+          remap[from] = to;
+          quadrics[to] += quadrics[from];
+          // neighbourhood of collapse is changed, so the rest of it waits for next pass
+          for (const GLuint v : { from, to })
+          {
+            for (size_t a = adjacency_offsets[v]; a < adjacency_offsets[v + 1]; a++)
+            {
+              const size_t t = adjacency[a] * 3;
+              locked[triangles[t]] = locked[triangles[t + 1]] = locked[triangles[t + 2]] = 1;
+            }
+          }
+          removed += collapsed_triangles;
+        }
+        if (removed == 0)
+        {
+          break;
+        }
+
+        // drop triangles that became degenerate
+        size_t write = 0;
+        for (size_t i = 0; i < triangles.size(); i += 3)
+        {
+          const GLuint a = remap[triangles[i]], b = remap[triangles[i + 1]], c = remap[triangles[i + 2]];
+          if (a == b || b == c || a == c)
+          {
+            continue;
+          }
+          triangles[write] = a;
+          triangles[write + 1] = b;
+          triangles[write + 2] = c;
+          corners[write] = corners[i];
+          corners[write + 1] = corners[i + 1];
+          corners[write + 2] = corners[i + 2];
+          write += 3;
+        }
+        triangles.resize(write);
+        corners.resize(write);
+        directed_edges.clear();
+        for (size_t i = 0; i < triangles.size(); i += 3)
+        {
+          for (int k = 0; k < 3; k++)
+          {
+            directed_edges[{ triangles[i + k], triangles[i + (k + 1) % 3] }]++;
+          }
+        }
+      }
+
+      // corner keeps its own vertex (normal, uv) while its position is not moved
+      std::vector<GLuint> result(triangles.size());
+      for (size_t i = 0; i < triangles.size(); i++)
+      {
+        result[i] = weld[corners[i]] == triangles[i] ? corners[i] : triangles[i];
+      }
+      return result;
+    }
+
+    float get_screen_size(float radius, float distance, float fovy_deg)
+    {
+      if (distance <= radius)
+      {
+        return std::numeric_limits<float>::max();
+      }
+      return radius / (distance * std::tan(glm::radians(fovy_deg) * 0.5f));
+    }
+
+    uint32_t select_lod(float screen_size, uint32_t current_lod, uint32_t lod_count)
+    {
+      if (lod_count <= 1)
+      {
+        return 0;
+      }
+      current_lod = std::min(current_lod, lod_count - 1);
+      uint32_t lod = 0;
+      while (lod + 1 < lod_count && screen_size < switch_screen_sizes[lod])
+      {
+        lod++;
+      }
+      // move across each switch size only when object is clearly past it
+      while (lod > current_lod && screen_size >= switch_screen_sizes[lod - 1] * (1.f - hysteresis))
+      {
+        lod--;
+      }
+      while (lod < current_lod && screen_size <= switch_screen_sizes[lod] * (1.f + hysteresis))
+      {
+        lod++;
+      }
+      return lod;
+    }
+  }
+}
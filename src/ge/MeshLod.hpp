@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+using GLuint = unsigned int;
+
+namespace fury
+{
+  // Levels of detail of a mesh. Level 0 is the mesh itself, every next level has about half of triangles of previous one
+  namespace mesh_lod
+  {
+    constexpr uint32_t max_lods = 4;
+    // meshes with fewer triangles are not simplified
+    constexpr size_t min_triangles = 256;
+    // projected bounding sphere diameter in fractions of screen height, below which next level is used
+    constexpr std::array<float, max_lods - 1> switch_screen_sizes = { 0.25f, 0.12f, 0.05f };
+    // object has to get this much past switch size before level changes, so that it doesn't flicker on the edge
+    constexpr float hysteresis = 0.1f;
+    // quadric error edge collapse. vertices with the same position are welded, so unwelded meshes are simplified too.
+    // returned triangles reference original vertices, so vertex buffer is shared by all levels
+    std::vector<GLuint> simplify(const std::vector<glm::vec3>& positions, const std::vector<GLuint>& indices, size_t target_index_count);
+    // bounding sphere diameter relative to screen height
+    float get_screen_size(float radius, float distance, float fovy_deg);
+    uint32_t select_lod(float screen_size, uint32_t current_lod, uint32_t lod_count);
+  }
+}
@@ -1,5 +1,6 @@
 #include "Object3D.hpp"
 #include "core/Logger.hpp"
+#include <algorithm>
 
 namespace fury
 {
@@ -54,29 +55,8 @@ namespace fury
 
   void Object3D::set_color(const glm::vec4& color)
   {
+    // vertices aren't touched, color tints vertex colors in shader
     m_color = color;
-    auto apply_color = [](std::vector<Mesh>& meshes, const glm::vec4& color)
-      {
-        for (auto& mesh : meshes)
-        {
-          for (auto& vertex : mesh.vertices())
-          {
-            vertex.color = color;
-          }
-        }
-      };
-
-    // set color of current mesh
-    apply_color(*m_meshes, color);
-
-    // set color of cached meshes
-    for (auto& cached_meshes : m_cached_meshes)
-    {
-      if (cached_meshes)
-      {
-        apply_color(*cached_meshes, color);
-      }
-    }
   }
 
   glm::vec3 Object3D::center() const
@@ -134,6 +114,22 @@ namespace fury
       }
       ShadingProcessor::apply_shading(*m_meshes, mode);
       m_shading_mode = mode;
+      // shaded copy has its own vertices, so levels are simplified again
+      if (std::any_of(current_meshes_tmp->begin(), current_meshes_tmp->end(), [](const Mesh& mesh) { return mesh.lod_count() > 1; }))
+      {
+        generate_lods();
+      }
+    }
+  }
+
+  void Object3D::generate_lods()
+  {
+    for (Mesh& mesh : *m_meshes)
+    {
+      if (mesh.lod_count() == 1)
+      {
+        mesh.generate_lods();
+      }
     }
   }
 }
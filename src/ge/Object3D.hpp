@@ -39,11 +39,14 @@ namespace fury
     static T* cast_to(Object3D* obj) { return static_cast<T*>(obj); }
     template<typename T>
     T* cast_to() { return static_cast<T*>(this); }
+    // tint of the object, multiplied with vertex colors
     void set_color(const glm::vec4& color);
     ObjectGeometryMetadata get_geometry_metadata() const;
     glm::vec3 center() const;
     void update();
     void apply_shading(ShadingMode mode);
+    // generates levels of detail for meshes that don't have them yet
+    void generate_lods();
     void set_shading_mode(ShadingMode mode) { m_shading_mode = mode; }
     void set_meshes_data(const std::shared_ptr<std::vector<Mesh>>& meshes) { m_meshes = meshes; }
     void add_mesh(Mesh&& mesh);
@@ -1,4 +1,6 @@
 #include "Vertex.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace fury
 {
@@ -14,4 +16,46 @@ namespace fury
   Vertex::Vertex(float x, float y, float z) : position(glm::vec3(x, y, z))
   {
   }
+
+  namespace vertex_packing
+  {
+    glm::vec2 oct_encode(const glm::vec3& n)
+    {
+      const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+      if (l1 == 0.f)
+      {
+        return glm::vec2(0.f);
+      }
+      glm::vec2 e = glm::vec2(n.x, n.y) / l1;
+      if (n.z < 0.f)
+      {
+        // fold lower hemisphere over diagonals
+        e = glm::vec2((1.f - std::abs(e.y)) * (e.x >= 0.f ? 1.f : -1.f), (1.f - std::abs(e.x)) * (e.y >= 0.f ? 1.f : -1.f));
+      }
+      return e;
+    }
+
+    glm::vec3 oct_decode(const glm::vec2& e)
+    {
+      glm::vec3 n(e.x, e.y, 1.f - std::abs(e.x) - std::abs(e.y));
+      const float t = std::max(-n.z, 0.f);
+      n.x += n.x >= 0.f ? -t : t;
+      n.y += n.y >= 0.f ? -t : t;
+      return glm::normalize(n);
+    }
+
+    PackedVertex pack(const Vertex& v, const glm::vec3& bounds_min, const glm::vec3& bounds_size)
+    {
+      PackedVertex packed;
+      for (int i = 0; i < 3; i++)
+      {
+        const float t = bounds_size[i] > 0.f ? (v.position[i] - bounds_min[i]) / bounds_size[i] : 0.f;
+        packed.position[i] = static_cast<uint16_t>(std::round(std::clamp(t, 0.f, 1.f) * 65535.f));
+      }
+      packed.normal = glm::packSnorm2x16(oct_encode(v.normal));
+      packed.color = glm::packUnorm4x8(v.color);
+      packed.uv = glm::packHalf2x16(v.uv);
+      return packed;
+    }
+  }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 
 namespace fury
 {
@@ -14,4 +15,28 @@ namespace fury
     glm::vec4 color = glm::vec4(1.f);
     glm::vec2 uv = {};
   };
+
+  // 20 bytes GPU layout of Vertex. position is quantized to 16 bits within bounds of its mesh,
+  // normal is octahedral encoded, color is rgba8 and uv are half floats
+  struct PackedVertex
+  {
+    uint16_t position[3] = {};
+    uint16_t pad = 0;
+    // 2 snorm16
+    uint32_t normal = 0;
+    // unorm8 rgba
+    uint32_t color = 0;
+    // 2 half floats
+    uint32_t uv = 0;
+  };
+  static_assert(sizeof(PackedVertex) == 20);
+
+  namespace vertex_packing
+  {
+    // maps unit vector to [-1, 1] square
+    glm::vec2 oct_encode(const glm::vec3& n);
+    glm::vec3 oct_decode(const glm::vec2& e);
+    // position is stored as (position - bounds_min) / bounds_size
+    PackedVertex pack(const Vertex& v, const glm::vec3& bounds_min, const glm::vec3& bounds_size);
+  }
 }
@@ -0,0 +1,23 @@
+#version 440 core
+
+// vertex of unit primitive mesh
+layout (location = 0) in vec3 aPos;
+// per instance, transform takes locations 1-4
+layout (location = 1) in mat4 instanceTransform;
+layout (location = 5) in vec4 instanceColor;
+
+layout (std140, binding = 0) uniform CameraData
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+} camData;
+
+out vec4 vColor;
+
+void main()
+{
+  // frusta are drawn with inverse view projection, so w isn't 1
+  vec4 world = instanceTransform * vec4(aPos, 1.0);
+  gl_Position = (camData.projectionMatrix * camData.viewMatrix) * vec4(world.xyz / world.w, 1.0);
+  vColor = instanceColor;
+}
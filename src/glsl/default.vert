@@ -1,5 +1,7 @@
 #version 440 core
 
+#extension GL_ARB_shader_draw_parameters : require
+
 const int g_directionalLightType = 0;
 
 layout (location = 0) in vec3 aPos;
@@ -42,27 +44,59 @@ layout (std430, binding = 2) buffer Lights
 	LightInfo lightInfos[];
 };
 
-uniform mat4 modelMatrix;
+struct DrawData
+{
+	mat4 modelMatrix;
+	uint materialIndex;
+	uint applyShading;
+	// rgba8 tint
+	uint color;
+	uint objectId;
+	// dequantization of packed positions
+	vec4 positionOffset;
+	vec4 positionScale;
+};
+
+layout (std430, binding = 3) readonly buffer DrawDataBuffer
+{
+	DrawData drawData[];
+};
+
 uniform int numLights;
+// normal is octahedral encoded in xy
+uniform int packedVertices;
 
+flat out uint materialIndex;
+flat out uint applyShading;
 out vec3 normal;
 out vec4 color;
 out vec3 fragment;
 out vec2 uv;
-out vec4 fragPosDirectionalLightSpace;
+out float viewDepth;
+
+vec3 octDecode(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+	return normalize(n);
+}
 
 void main()
 {
-	gl_Position = (camData.projectionMatrix * camData.viewMatrix * modelMatrix) * vec4(aPos, 1.0);
-	fragment = vec3(modelMatrix * vec4(aPos, 1.0f));
-	normal = normalize(transpose(inverse(mat3(modelMatrix))) * aNormal);
-	color = aColor;
+	// every draw (direct or indirect) passes index of its first draw data as base instance,
+	// draw data of instances follows it. gl_InstanceID doesn't include base instance
+	DrawData data = drawData[gl_BaseInstanceARB + gl_InstanceID];
+	mat4 model = data.modelMatrix;
+	materialIndex = data.materialIndex;
+	applyShading = data.applyShading;
+	vec3 pos = data.positionOffset.xyz + aPos * data.positionScale.xyz;
+	gl_Position = (camData.projectionMatrix * camData.viewMatrix * model) * vec4(pos, 1.0);
+	fragment = vec3(model * vec4(pos, 1.0f));
+	// selects shadow cascade
+	viewDepth = -(camData.viewMatrix * vec4(fragment, 1.0)).z;
+	vec3 objectNormal = packedVertices != 0 ? octDecode(aNormal.xy) : aNormal;
+	normal = normalize(transpose(inverse(mat3(model))) * objectNormal);
+	color = aColor * unpackUnorm4x8(data.color);
 	uv = aTextCoord;
-	for (int i = 0; i < numLights; i++)
-	{
-		if (lightInfos[i].type == g_directionalLightType)
-		{
-			fragPosDirectionalLightSpace = lightInfos[i].shadowMatrix * vec4(fragment, 1);
-		}
-	}
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#version 440 core
+
+layout (std140, binding = 0) uniform CameraData
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+} camData;
+
+// g-buffer, must match DeferredGeometryPass
+layout (binding = 0) uniform sampler2D gAlbedo;
+layout (binding = 1) uniform sampler2D gNormal;
+layout (binding = 2) uniform usampler2D gMaterial;
+layout (binding = 3) uniform sampler2D gDepth;
+
+uniform mat4 invViewProjMatrix;
+
+out vec4 fragColor;
+
+// lighting.frag
+vec4 CalculateLighting(vec3 fragment, vec3 normal, float viewDepth, vec3 ambientColor, vec3 diffuseColor, vec3 specularColor, float shininess);
+
+vec3 OctDecode(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+	return normalize(n);
+}
+
+void main()
+{
+	ivec2 coord = ivec2(gl_FragCoord.xy);
+	float depth = texelFetch(gDepth, coord, 0).r;
+	// nothing was drawn there, skybox stays
+	if (depth == 1.0)
+	{
+		discard;
+	}
+	vec4 albedo = texelFetch(gAlbedo, coord, 0);
+	fragColor = vec4(albedo.rgb, 1.0);
+	if (albedo.a == 0.0)
+	{
+		return;
+	}
+	// world position from depth
+	vec2 screenUv = (vec2(coord) + 0.5) / vec2(textureSize(gDepth, 0));
+	vec4 world = invViewProjMatrix * vec4(vec3(screenUv, depth) * 2.0 - 1.0, 1.0);
+	vec3 fragment = world.xyz / world.w;
+	float viewDepth = -(camData.viewMatrix * vec4(fragment, 1.0)).z;
+	vec3 normal = OctDecode(texelFetch(gNormal, coord, 0).xy);
+	uvec4 material = texelFetch(gMaterial, coord, 0);
+	fragColor *= CalculateLighting(fragment, normal, viewDepth, unpackUnorm4x8(material.x).rgb, unpackUnorm4x8(material.y).rgb,
+		unpackUnorm4x8(material.z).rgb, uintBitsToFloat(material.w));
+}
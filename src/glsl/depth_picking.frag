@@ -1,10 +1,10 @@
 #version 440 core
 
-out uvec4 FragColor;
-  
-uniform uint objectIndex;
+out uint FragColor;
+
+flat in uint objectId;
 
 void main()
 {
-    FragColor = uvec4(objectIndex, 50, 20, 1);
+    FragColor = objectId;
 }
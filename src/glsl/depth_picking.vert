@@ -1,16 +1,36 @@
 #version 440 core
 
+#extension GL_ARB_shader_draw_parameters : require
+
 layout (location = 0) in vec3 aPos;
 
-layout (std140, binding = 0) uniform CameraData
+struct DrawData
+{
+	mat4 modelMatrix;
+	uint materialIndex;
+	uint applyShading;
+	// rgba8 tint
+	uint color;
+	uint objectId;
+	// dequantization of packed positions
+	vec4 positionOffset;
+	vec4 positionScale;
+};
+
+layout (std430, binding = 3) readonly buffer DrawDataBuffer
 {
-	mat4 viewMatrix;
-	mat4 projectionMatrix;
-} camData;
+	DrawData drawData[];
+};
+
+// camera view projection narrowed to picked pixel
+uniform mat4 viewProjMatrix;
 
-uniform mat4 modelMatrix;
+flat out uint objectId;
 
 void main()
 {
-    gl_Position = (camData.projectionMatrix * camData.viewMatrix * modelMatrix) * vec4(aPos, 1.0);
+    DrawData data = drawData[gl_BaseInstanceARB + gl_InstanceID];
+    vec3 pos = data.positionOffset.xyz + aPos * data.positionScale.xyz;
+    gl_Position = viewProjMatrix * data.modelMatrix * vec4(pos, 1.0);
+    objectId = data.objectId;
 }
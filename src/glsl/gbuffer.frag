@@ -0,0 +1,68 @@
+#version 440 core
+
+// texture units layout, must match GeometryPass
+const int g_textureTableSize = 12;
+const int g_overflowTextureSlots = 3;
+
+struct Material
+{
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	float shininess;
+	float alpha;
+	// texture units or -1 if there is no texture
+	int ambientTex;
+	int diffuseTex;
+	int specularTex;
+};
+
+layout (std430, binding = 4) readonly buffer Materials
+{
+	Material materials[];
+};
+
+// g-buffer layout, must match DeferredGeometryPass
+// rgb - base color, a - 1 if fragment is shaded
+layout (location = 0) out vec4 gAlbedo;
+// octahedral encoded normal
+layout (location = 1) out vec2 gNormal;
+// rgba8 ambient, diffuse and specular colors, bits of shininess
+layout (location = 2) out uvec4 gMaterial;
+
+flat in uint materialIndex;
+flat in uint applyShading;
+in vec3 normal;
+in vec4 color;
+in vec3 fragment;
+in vec2 uv;
+in float viewDepth;
+
+// material index is the same for whole draw, so indexing is dynamically uniform
+layout (binding = 0) uniform sampler2D materialTextures[g_textureTableSize + g_overflowTextureSlots];
+
+vec2 OctEncode(vec3 n)
+{
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	vec2 e = n.xy;
+	if (n.z < 0.0)
+	{
+		e = (1.0 - abs(e.yx)) * mix(vec2(-1.0), vec2(1.0), greaterThanEqual(e, vec2(0.0)));
+	}
+	return e;
+}
+
+void main()
+{
+	Material meshMaterial = materials[materialIndex];
+	vec4 baseColor = color;
+	if (meshMaterial.diffuseTex >= 0) {
+		baseColor *= texture(materialTextures[meshMaterial.diffuseTex], uv);
+	}
+	gAlbedo = vec4(baseColor.rgb, applyShading != 0 ? 1.0 : 0.0);
+	gNormal = OctEncode(normalize(normal));
+	vec3 ambientColor = meshMaterial.ambientTex >= 0 ? texture(materialTextures[meshMaterial.ambientTex], uv).rgb : meshMaterial.ambient.rgb;
+	vec3 specularColor = meshMaterial.specularTex >= 0 ? texture(materialTextures[meshMaterial.specularTex], uv).rgb : meshMaterial.specular.rgb;
+	gMaterial = uvec4(packUnorm4x8(vec4(ambientColor, 0.0)), packUnorm4x8(vec4(meshMaterial.diffuse.rgb, 0.0)),
+		packUnorm4x8(vec4(specularColor, 0.0)), floatBitsToUint(meshMaterial.shininess));
+}
@@ -0,0 +1,227 @@
+#version 440 core
+
+// Phong lighting shared by forward and deferred shading, linked into their fragment programs
+
+const int g_directionalLightType = 0;
+const int g_pointLightType = 1;
+const int g_spotLightType = 2;
+
+struct LightInfo
+{
+	// common info
+	vec4 pos;
+	vec4 dir;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	mat4 shadowMatrix;
+
+	// attenuation info for point light
+	float constant;
+	float linear;
+	float quadratic;
+
+	// info for spot light
+	float cutoff;
+	float outerCutoff;
+	int smoothSpotLight;
+
+	// 0 - directional, 1 - point, 2 - spot
+	int type;
+};
+
+layout (std430, binding = 2) buffer Lights
+{
+	LightInfo lightInfos[];
+};
+
+// light clusters, must match light_clusters namespace
+const uint g_clustersX = 16;
+const uint g_clustersY = 9;
+const uint g_clustersZ = 24;
+
+struct Cluster
+{
+	// into clusterLightIndices
+	uint offset;
+	uint count;
+};
+
+layout (std430, binding = 9) readonly buffer LightClusters
+{
+	Cluster clusters[];
+};
+
+// global lights go first, they affect every cluster
+layout (std430, binding = 10) readonly buffer ClusterLightIndices
+{
+	uint clusterLightIndices[];
+};
+
+// cascades of directional light, must match ShadowsPass
+const int g_shadowCascadesCount = 4;
+layout (std140, binding = 2) uniform ShadowCascades
+{
+	mat4 cascadeMatrices[g_shadowCascadesCount];
+	// far distance of each cascade in view space
+	vec4 cascadeSplits;
+} shadowData;
+layout (binding = 15) uniform sampler2DArray shadowMaps;
+uniform vec3 viewPos;
+uniform int numLights;
+uniform int numGlobalLights;
+// xy - size of cluster tile in pixels, z and w - scale and bias of log(view depth) to depth slice
+uniform vec4 clusterParams;
+
+//vec2 poissonDisk[4] = vec2[](
+//  vec2( -0.94201624, -0.39906216 ),
+//  vec2( 0.94558609, -0.76890725 ),
+//  vec2( -0.094184101, -0.92938870 ),
+//  vec2( 0.34495938, 0.29387760 )
+//);
+//
+//// Returns a random number based on a vec3 and an int.
+//float random(vec3 seed, int i){
+//	vec4 seed4 = vec4(seed,i);
+//	float dot_product = dot(seed4, vec4(12.9898,78.233,45.164,94.673));
+//	return fract(sin(dot_product) * 43758.5453);
+//}
+
+Cluster GetCluster(float viewDepth)
+{
+	uvec2 tile = min(uvec2(gl_FragCoord.xy / clusterParams.xy), uvec2(g_clustersX - 1, g_clustersY - 1));
+	uint slice = uint(clamp(log(viewDepth) * clusterParams.z + clusterParams.w, 0.0, float(g_clustersZ - 1)));
+	return clusters[tile.x + g_clustersX * (tile.y + g_clustersY * slice)];
+}
+
+float CalculateShadowValue(vec3 fragment, vec3 normal, float viewDepth, vec3 directionalLightDir)
+{
+	int cascade = 0;
+	while (cascade < g_shadowCascadesCount && viewDepth > shadowData.cascadeSplits[cascade])
+	{
+		cascade++;
+	}
+	// no shadows further than last cascade
+	if (cascade == g_shadowCascadesCount)
+	{
+		return 0;
+	}
+	vec4 fragPosLightSpace = shadowData.cascadeMatrices[cascade] * vec4(fragment, 1.0);
+	// perform perspective divide and scale coord to [-1, 1] range
+	vec3 ndc = fragPosLightSpace.xyz / fragPosLightSpace.w;
+	// scale to range [0, 1] because depth values in shadow map are in range [0, 1]
+	ndc = ndc * 0.5 + 0.5;
+	// everything that is out of shadow map or if normal is facing away from light
+	float dp = dot(normal, -normalize(directionalLightDir));
+	if (ndc.z > 1.f || dp <= 0.0f || dp < 0.1)
+	{
+		return 0;
+	}
+	float currentDepth = ndc.z;
+	float bias = max(0.005 * (1.0 - dp), 0.001);
+	float shadow = 0.0;
+	vec2 texelSize = 1.0 / textureSize(shadowMaps, 0).xy;
+	int n = 1;
+	int total_texels = 0;
+	for(int x = -n; x <= n; ++x)
+	{
+			for(int y = -n; y <= n; ++y)
+			{
+				total_texels++;
+				float pcfDepth = texture(shadowMaps, vec3(ndc.xy + vec2(x, y) * texelSize, cascade)).r;
+				shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+			}
+	}
+	return shadow / total_texels;
+}
+
+// light that reaches fragment. material colors are multiplied with light colors, result multiplies base color
+vec4 CalculateLighting(vec3 fragment, vec3 normal, float viewDepth, vec3 ambientColor, vec3 diffuseColor, vec3 specularColor, float shininess)
+{
+	if (numLights == 0)
+	{
+		return vec4(1.0);
+	}
+	// Phong shading model
+	vec4 lightColor = vec4(0);
+	// only global lights and lights that reach cluster of the fragment
+	Cluster cluster = GetCluster(viewDepth);
+	uint clusterLightCount = uint(numGlobalLights) + cluster.count;
+	for (uint n = 0; n < clusterLightCount; n++)
+	{
+		uint lightIndex = n < uint(numGlobalLights) ? clusterLightIndices[n] : clusterLightIndices[cluster.offset + n - uint(numGlobalLights)];
+		LightInfo lightInfo = lightInfos[lightIndex];
+		vec3 ambientLightColor = lightInfo.ambient.rgb;
+		vec3 diffuseLightColor = lightInfo.diffuse.rgb;
+		vec3 specularLightColor = lightInfo.specular.rgb;
+
+		// ambient light
+		// more lights - less ambient impact
+		float ambientStrength = (1 / numLights) * 0.1;
+		vec3 ambient = ambientStrength * ambientLightColor * ambientColor;
+
+		//diffuse light
+		vec3 norm = normalize(normal);
+		vec3 lightDir = normalize(lightInfo.pos.rgb - fragment);
+		float diffuseValue = max(dot(norm, lightDir), 0.0);
+		vec3 diffuse = diffuseValue * diffuseLightColor * diffuseColor;
+
+		// specular light
+		float specularStrength = 0.5f;
+		vec3 viewDir = normalize(viewPos - fragment);
+		vec3 reflectedDir = reflect(-lightDir, norm);
+		float specValue = pow(max(dot(viewDir, reflectedDir), 0.0), shininess);
+		vec3 specular = specularStrength * specValue * specularLightColor * specularColor;
+
+		if (lightInfo.type == g_directionalLightType)
+		{
+			float shadow = CalculateShadowValue(fragment, normal, viewDepth, vec3(lightInfo.dir));
+			lightColor += vec4((ambient + (1.0 - shadow) * (diffuse + specular)), 1.0);
+		}
+		else
+		{
+			// point light stuff. also needed for spot light 
+			float distanceToFrag = length(lightInfo.pos.rgb - fragment);
+			float attenuation = 1.0f / (lightInfo.constant + lightInfo.linear * distanceToFrag + 
+																lightInfo.quadratic * (distanceToFrag * distanceToFrag));
+			// TODO: fix color banding
+			// https://computergraphics.stackexchange.com/questions/3964/opengl-specular-shading-gradient-banding-issues
+			ambient *= attenuation;
+			diffuse *= attenuation;
+			specular *= attenuation;
+		
+			// spot light stuff
+			if (lightInfo.type == g_spotLightType)
+			{
+				float angle = dot(vec3(-lightInfo.dir), lightDir);
+				if (bool(lightInfo.smoothSpotLight))
+				{
+					// clusters bound smooth spot light by its outer cone
+					if (angle < lightInfo.outerCutoff)
+					{
+						continue;
+					}
+					// outer < inner
+					float epsilon = lightInfo.cutoff - lightInfo.outerCutoff;
+					//float intensity = clamp((angle - lightInfo.outerCutoff) / epsilon, 0.f, 1.f);
+					float intensity = smoothstep(lightInfo.outerCutoff, lightInfo.cutoff, angle);
+					diffuse *= intensity;
+					specular *= intensity;
+				}
+				else
+				{
+					// angle between direction from fragment to light and just light dir
+					if (angle < lightInfo.cutoff)
+					{
+						// remove impact of diffuse + specular
+						diffuse = vec3(0);
+						specular = vec3(0);
+						ambient *= 0.5;
+					}
+				}
+			}
+			lightColor += vec4((ambient + diffuse + specular), 1.0);
+		}
+	}
+	return lightColor;
+}
@@ -1,24 +1,66 @@
 #version 440 core
 
-#extension ARB_shader_draw_parameters : require
+#extension GL_ARB_shader_draw_parameters : require
 
-layout (location = 0) in vec3 pos;
-layout (location = 1) in vec3 normal;
+// two vertices per mesh vertex: its position and the end of its normal
+struct NormalsDrawData
+{
+  mat4 modelMatrix;
+  // dequantization of packed vertex positions
+  vec4 positionOffset;
+  vec4 positionScale;
+};
 
-out VS_OUT
+layout (std140, binding = 0) uniform CameraData
 {
-  vec3 normal;
-  mat4 modelMat;
-} vs_out;
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+} camData;
+
+layout (std430, binding = 1) readonly buffer NormalsDrawDataBuffer
+{
+  NormalsDrawData drawData[];
+};
 
-layout (std430, binding = 1) buffer ModelMatrices
+// vertex heap of geometry pass. Vertex is 12 floats, PackedVertex is 5 uints
+layout (std430, binding = 11) readonly buffer Vertices
 {
-  mat4 modelMatrices[];
+  uint vertices[];
 };
 
+uniform int packedVertices;
+// index of draw data of the first draw in multi draw
+uniform int drawOffset;
+
+vec3 octDecode(vec2 e)
+{
+  vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  float t = max(-n.z, 0.0);
+  n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+  return normalize(n);
+}
+
 void main()
 {
-    gl_Position = vec4(pos, 1.0);
-    vs_out.normal = normal;
-    vs_out.modelMat = modelMatrices[gl_DrawIDARB];
+  // gl_VertexID includes first of draw, which is twice the first vertex of mesh
+  int vertexIdx = gl_VertexID >> 1;
+  NormalsDrawData data = drawData[drawOffset + gl_DrawIDARB];
+  vec3 pos;
+  vec3 normal;
+  if (packedVertices != 0)
+  {
+    int base = vertexIdx * 5;
+    vec3 packedPos = vec3(unpackUnorm2x16(vertices[base]), unpackUnorm2x16(vertices[base + 1]).x);
+    pos = data.positionOffset.xyz + packedPos * data.positionScale.xyz;
+    normal = octDecode(unpackSnorm2x16(vertices[base + 2]));
+  }
+  else
+  {
+    int base = vertexIdx * 12;
+    pos = uintBitsToFloat(uvec3(vertices[base], vertices[base + 1], vertices[base + 2]));
+    normal = uintBitsToFloat(uvec3(vertices[base + 3], vertices[base + 4], vertices[base + 5]));
+  }
+  const float lenScaler = 5.0;
+  pos += normal / lenScaler * float(gl_VertexID & 1);
+  gl_Position = camData.projectionMatrix * camData.viewMatrix * data.modelMatrix * vec4(pos, 1.0);
 }
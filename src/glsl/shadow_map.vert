@@ -1,5 +1,7 @@
 #version 440 core
 
+#extension GL_ARB_shader_draw_parameters : require
+
 layout (location = 0) in vec3 aPos;
 
 //layout (std140, binding = 0) uniform CameraData
@@ -8,10 +10,29 @@ layout (location = 0) in vec3 aPos;
 //	mat4 projectionMatrix;
 //} camData;
 
+struct DrawData
+{
+	mat4 modelMatrix;
+	uint materialIndex;
+	uint applyShading;
+	// rgba8 tint
+	uint color;
+	uint objectId;
+	// dequantization of packed positions
+	vec4 positionOffset;
+	vec4 positionScale;
+};
+
+layout (std430, binding = 3) readonly buffer DrawDataBuffer
+{
+	DrawData drawData[];
+};
+
 uniform mat4 lightViewProjMatrix;
-uniform mat4 modelMatrix;
 
 void main()
 {
-    gl_Position = lightViewProjMatrix * modelMatrix * vec4(aPos, 1.0);
+    DrawData data = drawData[gl_BaseInstanceARB + gl_InstanceID];
+    vec3 pos = data.positionOffset.xyz + aPos * data.positionScale.xyz;
+    gl_Position = lightViewProjMatrix * data.modelMatrix * vec4(pos, 1.0);
 }
@@ -0,0 +1,75 @@
+#include "core/DebugPrimitives.hpp"
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace fury;
+
+namespace
+{
+	glm::vec3 transform_point(const debug_primitives::Instance& instance, const glm::vec3& p)
+	{
+		const glm::vec4 v = instance.transform * glm::vec4(p, 1.f);
+		return glm::vec3(v) / v.w;
+	}
+
+	void expect_near(const glm::vec3& a, const glm::vec3& b)
+	{
+		EXPECT_NEAR(a.x, b.x, 1e-3f);
+		EXPECT_NEAR(a.y, b.y, 1e-3f);
+		EXPECT_NEAR(a.z, b.z, 1e-3f);
+	}
+}
+
+TEST(DebugPrimitivesTest, MeshesAreLineLists)
+{
+	const debug_primitives::Meshes meshes = debug_primitives::make_meshes();
+	uint32_t end = 0;
+	for (const debug_primitives::MeshRange& range : meshes.ranges)
+	{
+		EXPECT_EQ(range.first, end);
+		EXPECT_GT(range.count, 0u);
+		EXPECT_EQ(range.count % 2, 0u);
+		end = range.first + range.count;
+	}
+	EXPECT_EQ(end, meshes.vertices.size());
+	const auto& sphere = meshes.ranges[static_cast<size_t>(debug_primitives::Type::SPHERE)];
+	EXPECT_EQ(sphere.count, 3 * 2 * debug_primitives::sphere_segments);
+	for (uint32_t i = sphere.first; i < sphere.first + sphere.count; i++)
+	{
+		EXPECT_NEAR(glm::length(meshes.vertices[i]), 1.f, 1e-5f);
+	}
+}
+
+TEST(DebugPrimitivesTest, LineMapsUnitSegment)
+{
+	const auto line = debug_primitives::line(glm::vec3(1, 2, 3), glm::vec3(-4, 5, 0), glm::vec4(1, 0, 0, 1));
+	expect_near(transform_point(line, glm::vec3(0.f)), glm::vec3(1, 2, 3));
+	expect_near(transform_point(line, glm::vec3(1, 0, 0)), glm::vec3(-4, 5, 0));
+	EXPECT_EQ(line.color, glm::vec4(1, 0, 0, 1));
+}
+
+TEST(DebugPrimitivesTest, SphereScalesUnitSphere)
+{
+	const auto sphere = debug_primitives::sphere(glm::vec3(1, 0, 0), 2.f, glm::vec4(1.f));
+	expect_near(transform_point(sphere, glm::vec3(0, 1, 0)), glm::vec3(1, 2, 0));
+	expect_near(transform_point(sphere, glm::vec3(0, 0, -1)), glm::vec3(1, 0, -2));
+}
+
+TEST(DebugPrimitivesTest, FrustumCornersAreOnPlanes)
+{
+	const glm::mat4 proj = glm::perspective(glm::radians(90.f), 1.f, 1.f, 10.f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.f), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+	const auto frustum = debug_primitives::frustum(proj * view, glm::vec4(1.f));
+	// 90 degrees fov, so half size of plane is its distance
+	expect_near(transform_point(frustum, glm::vec3(1, 1, -1)), glm::vec3(1, 1, -1));
+	expect_near(transform_point(frustum, glm::vec3(-1, -1, 1)), glm::vec3(-10, -10, -10));
+}
+
+TEST(DebugPrimitivesTest, BoxCoversTransformedBounds)
+{
+	const BoundingBox bbox(glm::vec3(-1, 0, 0), glm::vec3(1, 2, 4));
+	const glm::mat4 transform = glm::translate(glm::mat4(1.f), glm::vec3(10, 0, 0)) * glm::scale(glm::mat4(1.f), glm::vec3(2.f));
+	const auto box = debug_primitives::box(bbox, transform, glm::vec4(1.f));
+	expect_near(transform_point(box, glm::vec3(-0.5f)), glm::vec3(8, 0, 0));
+	expect_near(transform_point(box, glm::vec3(0.5f)), glm::vec3(12, 4, 8));
+}
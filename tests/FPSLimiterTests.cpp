@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "core/FPSLimiter.hpp"
+
+using namespace fury;
+using namespace std::chrono_literals;
+
+TEST(FPSLimiterTest, DeadlineAdvancesByFrameTime)
+{
+	const FPSLimiter::clock::time_point deadline{ 1s };
+	// late by less than a frame, next deadline stays on the grid
+	EXPECT_EQ(FPSLimiter::advance_deadline(deadline, 10ms, deadline + 3ms), deadline + 10ms);
+	EXPECT_EQ(FPSLimiter::advance_deadline(deadline, 10ms, deadline), deadline + 10ms);
+}
+
+TEST(FPSLimiterTest, MissedDeadlineIsNotCaughtUp)
+{
+	const FPSLimiter::clock::time_point deadline{ 1s };
+	const FPSLimiter::clock::time_point now = deadline + 25ms;
+	EXPECT_EQ(FPSLimiter::advance_deadline(deadline, 10ms, now), now + 10ms);
+}
+
+TEST(FPSLimiterTest, WaitDoesNotReturnEarly)
+{
+	const auto start = FPSLimiter::clock::now();
+	FPSLimiter limiter(200);
+	EXPECT_NEAR(limiter.get_target_frame_time(), 0.005f, 1e-6f);
+	constexpr int frames = 10;
+	for (int i = 0; i < frames; i++)
+	{
+		limiter.wait();
+	}
+	EXPECT_GE(FPSLimiter::clock::now() - start, frames * 5ms);
+	// first frame may return late, so average can be slightly below target
+	EXPECT_GE(limiter.get_achieved_frame_time(), 0.005f * 0.9f);
+}
+
+TEST(FPSLimiterTest, NoJitterWithoutLimit)
+{
+	FPSLimiter limiter;
+	limiter.wait();
+	limiter.wait();
+	EXPECT_EQ(limiter.get_target_frame_time(), 0.f);
+	EXPECT_EQ(limiter.get_jitter(), 0.f);
+}
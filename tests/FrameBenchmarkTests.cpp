@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "core/FrameBenchmark.hpp"
+#include <sstream>
+
+using namespace fury;
+
+TEST(FrameBenchmarkTest, NearestRankPercentiles)
+{
+	std::vector<float> samples;
+	for (int i = 100; i >= 1; i--)
+	{
+		samples.push_back(static_cast<float>(i));
+	}
+	const FrameBenchmark::Percentiles p = FrameBenchmark::get_percentiles(samples);
+	EXPECT_FLOAT_EQ(p.p50, 50.f);
+	EXPECT_FLOAT_EQ(p.p95, 95.f);
+	EXPECT_FLOAT_EQ(p.p99, 99.f);
+	EXPECT_FLOAT_EQ(p.max, 100.f);
+	EXPECT_FLOAT_EQ(p.mean, 50.5f);
+	EXPECT_FLOAT_EQ(FrameBenchmark::get_percentiles({}).p99, 0.f);
+	EXPECT_FLOAT_EQ(FrameBenchmark::get_percentiles({ 7.f }).p50, 7.f);
+}
+
+TEST(FrameBenchmarkTest, ReportHasFramesPhasesAndUploads)
+{
+	FrameBenchmark benchmark(2);
+	benchmark.add_phase_time("Tick", 1.f);
+	benchmark.add_phase_time("Render", 4.f);
+	benchmark.add_frame(6.f, 1024);
+	benchmark.add_phase_time("Tick", 2.f);
+	benchmark.add_phase_time("Render", 5.f);
+	benchmark.add_frame(8.f, 2048);
+	EXPECT_EQ(benchmark.get_recorded_frames(), 2u);
+	std::ostringstream os;
+	benchmark.write_report(os);
+	const std::string report = os.str();
+	EXPECT_NE(report.find("\"frames\":2"), std::string::npos);
+	EXPECT_NE(report.find("\"frame_time_ms\":{\"p50\":6,\"p95\":8"), std::string::npos);
+	EXPECT_NE(report.find("\"upload_bytes\":{\"p50\":1024"), std::string::npos);
+	// phases keep order of first appearance
+	EXPECT_LT(report.find("\"Tick\""), report.find("\"Render\""));
+}
+
+TEST(FrameBenchmarkTest, CameraOrbitsBoundsCenter)
+{
+	const FrameBenchmark benchmark(100);
+	const BoundingBox bounds(glm::vec3(-10.f), glm::vec3(30.f));
+	const FrameBenchmark::CameraPose first = benchmark.get_camera_pose(bounds, 0);
+	const FrameBenchmark::CameraPose middle = benchmark.get_camera_pose(bounds, 50);
+	EXPECT_EQ(first.target, bounds.center());
+	// opposite sides of the orbit
+	EXPECT_NEAR(first.position.x - 10.f, -(middle.position.x - 10.f), 1e-3f);
+	EXPECT_NEAR(glm::length(first.position - bounds.center()), glm::length(middle.position - bounds.center()), 1e-3f);
+}
@@ -0,0 +1,74 @@
+#include "core/FreeListAllocator.hpp"
+#include <gtest/gtest.h>
+
+using namespace fury;
+
+TEST(FreeListAllocatorTest, AllocateUntilFull)
+{
+  FreeListAllocator allocator(100);
+  EXPECT_EQ(allocator.allocate(40), 0u);
+  EXPECT_EQ(allocator.allocate(60), 40u);
+  EXPECT_FALSE(allocator.allocate(1).has_value());
+  EXPECT_EQ(allocator.used(), 100u);
+  // zero sized allocation doesn't need space
+  EXPECT_EQ(allocator.allocate(0), 0u);
+}
+
+TEST(FreeListAllocatorTest, FreeMergesNeighbours)
+{
+  FreeListAllocator allocator(90);
+  const size_t a = *allocator.allocate(30);
+  const size_t b = *allocator.allocate(30);
+  const size_t c = *allocator.allocate(30);
+  allocator.free(a, 30);
+  allocator.free(c, 30);
+  EXPECT_EQ(allocator.free_blocks_count(), 2u);
+  EXPECT_TRUE(allocator.has_holes());
+  allocator.free(b, 30);
+  EXPECT_EQ(allocator.free_blocks_count(), 1u);
+  EXPECT_EQ(allocator.largest_free_block(), 90u);
+  EXPECT_EQ(allocator.used(), 0u);
+  EXPECT_FALSE(allocator.has_holes());
+}
+
+TEST(FreeListAllocatorTest, FirstFitReusesHole)
+{
+  FreeListAllocator allocator(100);
+  const size_t a = *allocator.allocate(20);
+  allocator.allocate(20);
+  allocator.free(a, 20);
+  EXPECT_EQ(allocator.allocated_end(), 40u);
+  EXPECT_EQ(allocator.allocate(10), 0u);
+  EXPECT_EQ(allocator.allocate(15), 40u);
+  EXPECT_EQ(allocator.allocate(10), 10u);
+  EXPECT_FALSE(allocator.has_holes());
+}
+
+TEST(FreeListAllocatorTest, GrowExtendsLastFreeBlock)
+{
+  FreeListAllocator allocator(50);
+  allocator.allocate(40);
+  EXPECT_FALSE(allocator.allocate(20).has_value());
+  allocator.grow(100);
+  EXPECT_EQ(allocator.capacity(), 100u);
+  EXPECT_EQ(allocator.free_blocks_count(), 1u);
+  EXPECT_EQ(allocator.allocate(60), 40u);
+  EXPECT_EQ(allocator.used(), 100u);
+}
+
+TEST(FreeListAllocatorTest, DoubleFreeOfMergedBlockIsRejected)
+{
+  FreeListAllocator allocator(100);
+  const size_t a = *allocator.allocate(20);
+  const size_t b = *allocator.allocate(20);
+  allocator.allocate(60);
+  allocator.free(a, 20);
+  allocator.free(b, 20);
+  // b is inside free block [0, 40) now
+  allocator.free(b, 20);
+  EXPECT_EQ(allocator.used(), 60u);
+  EXPECT_EQ(allocator.free_blocks_count(), 1u);
+  EXPECT_EQ(allocator.largest_free_block(), 40u);
+  EXPECT_EQ(allocator.allocate(40), 0u);
+  EXPECT_FALSE(allocator.allocate(1).has_value());
+}
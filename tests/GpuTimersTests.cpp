@@ -0,0 +1,31 @@
+#include "gtest/gtest.h"
+#include "core/GpuTimers.hpp"
+
+using namespace fury;
+
+TEST(GpuTimersTest, SectionStatsOfPartialHistory)
+{
+	GpuTimers::Section section("Geometry");
+	EXPECT_EQ(section.average(), 0.f);
+	EXPECT_EQ(section.max(), 0.f);
+	section.add_sample(1.f);
+	section.add_sample(3.f);
+	section.add_sample(2.f);
+	EXPECT_FLOAT_EQ(section.average(), 2.f);
+	EXPECT_FLOAT_EQ(section.max(), 3.f);
+	EXPECT_FLOAT_EQ(section.last(), 2.f);
+}
+
+TEST(GpuTimersTest, SectionForgetsOldSamples)
+{
+	GpuTimers::Section section("Shadows");
+	section.add_sample(100.f);
+	for (size_t i = 0; i < GpuTimers::Section::history_size; i++)
+	{
+		section.add_sample(1.f);
+	}
+	// spike has left the window
+	EXPECT_FLOAT_EQ(section.max(), 1.f);
+	EXPECT_FLOAT_EQ(section.average(), 1.f);
+	EXPECT_FLOAT_EQ(section.last(), 1.f);
+}
@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "core/LaunchOptions.hpp"
+#include <stdexcept>
+
+using namespace fury;
+
+TEST(LaunchOptionsTest, DefaultsToWindowUntilClosed)
+{
+	const char* argv[] = { "FuryEngine" };
+	const LaunchOptions options = LaunchOptions::parse(1, argv);
+	EXPECT_FALSE(options.is_headless());
+	EXPECT_EQ(options.frame_count, 0u);
+}
+
+TEST(LaunchOptionsTest, HeadlessWithFrameCount)
+{
+	const char* argv[] = { "FuryEngine", "--headless", "--frames", "300" };
+	const LaunchOptions options = LaunchOptions::parse(4, argv);
+	EXPECT_EQ(options.headless, LaunchOptions::HeadlessContext::OSMESA);
+	EXPECT_EQ(options.frame_count, 300u);
+}
+
+TEST(LaunchOptionsTest, HeadlessContextSelection)
+{
+	const char* argv[] = { "FuryEngine", "--frames", "10", "--headless", "egl" };
+	EXPECT_EQ(LaunchOptions::parse(5, argv).headless, LaunchOptions::HeadlessContext::EGL);
+}
+
+TEST(LaunchOptionsTest, MalformedArgumentsThrow)
+{
+	const char* no_count[] = { "FuryEngine", "--frames" };
+	EXPECT_THROW(LaunchOptions::parse(2, no_count), std::invalid_argument);
+	const char* zero[] = { "FuryEngine", "--frames", "0" };
+	EXPECT_THROW(LaunchOptions::parse(3, zero), std::invalid_argument);
+	const char* garbage[] = { "FuryEngine", "--frames", "12x" };
+	EXPECT_THROW(LaunchOptions::parse(3, garbage), std::invalid_argument);
+	const char* unknown[] = { "FuryEngine", "--fullscreen" };
+	EXPECT_THROW(LaunchOptions::parse(2, unknown), std::invalid_argument);
+}
+
+TEST(LaunchOptionsTest, StressSceneOptionsInAnyOrder)
+{
+	const char* argv[] = { "FuryEngine", "--seed", "7", "--stress-scene", "50000", "--hierarchy-depth", "3",
+		"--animated", "0.5", "--lights", "16", "--textures", "8", "--model", "a.obj", "--model", "b.obj" };
+	const LaunchOptions options = LaunchOptions::parse(17, argv);
+	ASSERT_TRUE(options.stress_scene);
+	EXPECT_EQ(options.stress_scene->object_count, 50000u);
+	EXPECT_EQ(options.stress_scene->seed, 7u);
+	EXPECT_EQ(options.stress_scene->hierarchy_depth, 3u);
+	EXPECT_FLOAT_EQ(options.stress_scene->animated_fraction, 0.5f);
+	EXPECT_EQ(options.stress_scene->light_count, 16u);
+	EXPECT_EQ(options.stress_scene->texture_count, 8u);
+	EXPECT_EQ(options.stress_scene->model_files.size(), 2u);
+
+	const char* without_scene[] = { "FuryEngine", "--seed", "7" };
+	EXPECT_THROW(LaunchOptions::parse(3, without_scene), std::invalid_argument);
+	const char* bad_fraction[] = { "FuryEngine", "--stress-scene", "10", "--animated", "2" };
+	EXPECT_THROW(LaunchOptions::parse(5, bad_fraction), std::invalid_argument);
+}
+
+TEST(LaunchOptionsTest, BenchmarkWithOptionalReport)
+{
+	const char* defaults[] = { "FuryEngine", "--benchmark", "--headless" };
+	const LaunchOptions options = LaunchOptions::parse(3, defaults);
+	EXPECT_TRUE(options.benchmark);
+	EXPECT_TRUE(options.benchmark_report.empty());
+	EXPECT_TRUE(options.is_headless());
+	EXPECT_EQ(options.frame_count, LaunchOptions::default_benchmark_frames);
+
+	const char* with_report[] = { "FuryEngine", "--frames", "100", "--benchmark", "report.json" };
+	const LaunchOptions report_options = LaunchOptions::parse(5, with_report);
+	EXPECT_EQ(report_options.benchmark_report, "report.json");
+	EXPECT_EQ(report_options.frame_count, 100u);
+}
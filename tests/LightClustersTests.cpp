@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "core/LightClusters.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+
+using namespace fury;
+
+namespace
+{
+	constexpr float znear = 0.1f;
+	constexpr float zfar = 1000.f;
+
+	LightDescription make_point_light(const glm::vec3& pos)
+	{
+		LightDescription light;
+		light.type = LightType::POINT;
+		light.position = glm::vec4(pos, 1.f);
+		return light;
+	}
+
+	bool cluster_has_light(const light_clusters::Grid& grid, uint32_t cluster_idx, uint32_t light_idx)
+	{
+		const light_clusters::Cluster& cluster = grid.clusters[cluster_idx];
+		const auto begin = grid.light_indices.begin() + cluster.offset;
+		return std::find(begin, begin + cluster.count, light_idx) != begin + cluster.count;
+	}
+}
+
+TEST(LightClustersTest, RangeMatchesCutoff)
+{
+	const LightDescription light = make_point_light(glm::vec3(0.f));
+	const float d = light_clusters::get_light_range(light);
+	ASSERT_GT(d, 0.f);
+	const float attenuation = 1.f / (light.constant + light.linear * d + light.quadratic * d * d);
+	EXPECT_NEAR(attenuation, light_clusters::attenuation_cutoff, 1e-5f);
+	LightDescription directional;
+	directional.type = LightType::DIRECTIONAL;
+	EXPECT_LT(light_clusters::get_light_range(directional), 0.f);
+}
+
+TEST(LightClustersTest, Slices)
+{
+	EXPECT_EQ(light_clusters::get_slice(znear * 0.5f, znear, zfar), 0u);
+	EXPECT_EQ(light_clusters::get_slice(zfar * 2.f, znear, zfar), light_clusters::grid_z - 1);
+	for (uint32_t i = 0; i < light_clusters::grid_z; i++)
+	{
+		const float depth = light_clusters::get_slice_near(i, znear, zfar) * 1.001f;
+		EXPECT_EQ(light_clusters::get_slice(depth, znear, zfar), i);
+	}
+}
+
+TEST(LightClustersTest, LightsAreBinnedIntoReachedClusters)
+{
+	const glm::mat4 projection = glm::perspective(glm::radians(45.f), 16.f / 9.f, znear, zfar);
+	const glm::mat4 view(1.f);
+	const auto bounds = light_clusters::compute_cluster_bounds(projection, znear, zfar);
+	std::vector<LightDescription> lights = { make_point_light(glm::vec3(0.f, 0.f, -10.f)) };
+	// reaches about 5 units
+	lights[0].quadratic = 10.f;
+	LightDescription directional;
+	directional.type = LightType::DIRECTIONAL;
+	lights.push_back(directional);
+
+	light_clusters::Grid grid;
+	light_clusters::build(lights, view, projection, znear, zfar, bounds, grid);
+	ASSERT_EQ(grid.global_light_count, 1u);
+	EXPECT_EQ(grid.light_indices[0], 1u);
+	// cluster in the middle of the screen at light depth
+	const uint32_t slice = light_clusters::get_slice(10.f, znear, zfar);
+	const uint32_t center = light_clusters::get_cluster_index(light_clusters::grid_x / 2, light_clusters::grid_y / 2, slice);
+	EXPECT_TRUE(cluster_has_light(grid, center, 0));
+	// screen corner right in front of camera and far behind the light
+	EXPECT_FALSE(cluster_has_light(grid, light_clusters::get_cluster_index(0, 0, 0), 0));
+	EXPECT_FALSE(cluster_has_light(grid, light_clusters::get_cluster_index(0, 0, light_clusters::grid_z - 1), 0));
+	// light reaches only a few clusters
+	size_t assigned = 0;
+	for (const light_clusters::Cluster& cluster : grid.clusters)
+	{
+		assigned += cluster.count;
+	}
+	EXPECT_GT(assigned, 0u);
+	EXPECT_LT(assigned, light_clusters::count / 4);
+}
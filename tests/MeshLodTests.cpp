@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "ge/MeshLod.hpp"
+
+using namespace fury;
+
+namespace
+{
+	// flat n x n quads grid on xz plane
+	void make_grid(int n, std::vector<glm::vec3>& positions, std::vector<GLuint>& indices)
+	{
+		for (int z = 0; z <= n; z++)
+		{
+			for (int x = 0; x <= n; x++)
+			{
+				positions.emplace_back(static_cast<float>(x), 0.f, static_cast<float>(z));
+			}
+		}
+		for (int z = 0; z < n; z++)
+		{
+			for (int x = 0; x < n; x++)
+			{
+				const GLuint i = z * (n + 1) + x;
+				indices.insert(indices.end(), { i, i + n + 1, i + 1, i + 1, i + n + 1, i + n + 2 });
+			}
+		}
+	}
+}
+
+TEST(MeshLodTest, SimplifyFlatGrid)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<GLuint> indices;
+	make_grid(16, positions, indices);
+	const std::vector<GLuint> lod = mesh_lod::simplify(positions, indices, indices.size() / 4);
+	EXPECT_EQ(lod.size() % 3, 0u);
+	EXPECT_LE(lod.size(), indices.size() / 2);
+	EXPECT_GT(lod.size(), 0u);
+	for (GLuint idx : lod)
+	{
+		ASSERT_LT(idx, positions.size());
+	}
+	// interior of flat grid collapses without error, border stays, so area is the same
+	float area = 0.f;
+	for (size_t i = 0; i < lod.size(); i += 3)
+	{
+		area += 0.5f * glm::length(glm::cross(positions[lod[i + 1]] - positions[lod[i]], positions[lod[i + 2]] - positions[lod[i]]));
+	}
+	EXPECT_NEAR(area, 256.f, 1e-3f);
+}
+
+TEST(MeshLodTest, SimplifyUnweldedMesh)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<GLuint> indices;
+	make_grid(16, positions, indices);
+	// every triangle gets its own vertices
+	std::vector<glm::vec3> unwelded_positions;
+	std::vector<GLuint> unwelded_indices;
+	for (GLuint idx : indices)
+	{
+		unwelded_indices.push_back(static_cast<GLuint>(unwelded_positions.size()));
+		unwelded_positions.push_back(positions[idx]);
+	}
+	const std::vector<GLuint> lod = mesh_lod::simplify(unwelded_positions, unwelded_indices, unwelded_indices.size() / 4);
+	EXPECT_LE(lod.size(), unwelded_indices.size() / 2);
+}
+
+TEST(MeshLodTest, SelectLodWithHysteresis)
+{
+	constexpr uint32_t lod_count = mesh_lod::max_lods;
+	const float first_switch = mesh_lod::switch_screen_sizes[0];
+	EXPECT_EQ(mesh_lod::select_lod(1.f, 0, lod_count), 0u);
+	EXPECT_EQ(mesh_lod::select_lod(0.001f, 0, lod_count), lod_count - 1);
+	// just below switch size keeps current level
+	EXPECT_EQ(mesh_lod::select_lod(first_switch * 0.95f, 0, lod_count), 0u);
+	EXPECT_EQ(mesh_lod::select_lod(first_switch * 0.85f, 0, lod_count), 1u);
+	// and just above it too when going back
+	EXPECT_EQ(mesh_lod::select_lod(first_switch * 1.05f, 1, lod_count), 1u);
+	EXPECT_EQ(mesh_lod::select_lod(first_switch * 1.15f, 1, lod_count), 0u);
+	// mesh without levels
+	EXPECT_EQ(mesh_lod::select_lod(0.001f, 2, 1), 0u);
+}
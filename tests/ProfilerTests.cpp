@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "core/Profiler.hpp"
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace fury;
+
+namespace
+{
+	std::string write_trace()
+	{
+		std::ostringstream os;
+		Profiler::write_chrome_trace(os);
+		return os.str();
+	}
+
+	size_t count_occurrences(const std::string& str, const std::string& sub)
+	{
+		size_t count = 0;
+		for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + sub.size()))
+		{
+			count++;
+		}
+		return count;
+	}
+}
+
+TEST(ProfilerTest, WritesCompleteEvents)
+{
+	Profiler::clear();
+	Profiler::record("Scene::tick", 2'000'500, 3'250'000);
+	const std::string trace = write_trace();
+	EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+	EXPECT_NE(trace.find("\"name\":\"Scene::tick\",\"ph\":\"X\",\"ts\":2000.500,\"dur\":1249.500"), std::string::npos);
+	EXPECT_EQ(count_occurrences(trace, "\"ph\":\"X\""), 1u);
+}
+
+TEST(ProfilerTest, ScopeRecordsItsDuration)
+{
+	Profiler::clear();
+	const int64_t before = Profiler::now_ns();
+	{
+		ProfileScope scope("Outer");
+		ProfileScope inner("Inner");
+	}
+	const std::string trace = write_trace();
+	EXPECT_EQ(count_occurrences(trace, "\"name\":\"Outer\""), 1u);
+	EXPECT_EQ(count_occurrences(trace, "\"name\":\"Inner\""), 1u);
+	EXPECT_GE(Profiler::now_ns(), before);
+}
+
+TEST(ProfilerTest, EscapesNames)
+{
+	Profiler::clear();
+	Profiler::record("say \"hi\"\\", 0, 1);
+	EXPECT_NE(write_trace().find("\"name\":\"say \\\"hi\\\"\\\\\""), std::string::npos);
+}
+
+TEST(ProfilerTest, RingKeepsNewestRecords)
+{
+	Profiler::clear();
+	Profiler::record("Oldest", 0, 1);
+	for (size_t i = 0; i < Profiler::thread_buffer_capacity; i++)
+	{
+		Profiler::record("Frame", 1000, 2000);
+	}
+	const std::string trace = write_trace();
+	EXPECT_EQ(trace.find("Oldest"), std::string::npos);
+	EXPECT_EQ(count_occurrences(trace, "\"name\":\"Frame\""), Profiler::thread_buffer_capacity);
+}
+
+TEST(ProfilerTest, ThreadsGetOwnBuffers)
+{
+	Profiler::clear();
+	Profiler::record("Main", 0, 1);
+	std::thread worker([] { Profiler::record("Worker", 0, 1); });
+	worker.join();
+	const std::string trace = write_trace();
+	const size_t main_pos = trace.find("\"name\":\"Main\"");
+	const size_t worker_pos = trace.find("\"name\":\"Worker\"");
+	ASSERT_NE(main_pos, std::string::npos);
+	ASSERT_NE(worker_pos, std::string::npos);
+	const auto tid_of = [&trace](size_t pos) {
+		const size_t tid_pos = trace.find("\"tid\":", pos);
+		return trace.substr(tid_pos, trace.find('}', tid_pos) - tid_pos);
+	};
+	EXPECT_NE(tid_of(main_pos), tid_of(worker_pos));
+}
+
+TEST(ProfilerTest, DisabledMacroRecordsNothing)
+{
+	Profiler::clear();
+	// FURY_ENABLE_PROFILER isn't defined for tests, so the macro expands to nothing
+	FURY_PROFILE_SCOPE("Disabled");
+	EXPECT_EQ(write_trace().find("Disabled"), std::string::npos);
+}
@@ -0,0 +1,89 @@
+#include "core/RenderGraph.hpp"
+#include <gtest/gtest.h>
+
+using namespace fury;
+
+namespace
+{
+	const RenderGraph::TextureDesc color_desc = { 1280, 720, GL_RGBA8, 1 };
+	const RenderGraph::TextureDesc depth_desc = { 1280, 720, GL_DEPTH24_STENCIL8, 1 };
+}
+
+TEST(RenderGraphTest, ReadersGoAfterWriters)
+{
+	RenderGraph graph;
+	const auto backbuffer = graph.import_framebuffer("backbuffer", 0);
+	const auto color = graph.create_texture("color", color_desc);
+	// declared before the pass that renders its input
+	const auto present = graph.add_pass("present", [&](RenderGraph::PassBuilder& b) { b.read(color); b.attach(backbuffer); }, [] {});
+	const auto scene = graph.add_pass("scene", [&](RenderGraph::PassBuilder& b) { b.attach(color); }, [] {});
+	ASSERT_TRUE(graph.compile());
+	const std::vector<RenderGraph::PassId> expected = { scene, present };
+	EXPECT_EQ(graph.get_execution_order(), expected);
+}
+
+TEST(RenderGraphTest, CullsPassesThatDontContribute)
+{
+	RenderGraph graph;
+	const auto backbuffer = graph.import_framebuffer("backbuffer", 0);
+	const auto color = graph.create_texture("color", color_desc);
+	const auto unused = graph.create_texture("unused", color_desc);
+	const auto scene = graph.add_pass("scene", [&](RenderGraph::PassBuilder& b) { b.attach(color); }, [] {});
+	const auto orphan = graph.add_pass("orphan", [&](RenderGraph::PassBuilder& b) { b.read(color); b.attach(unused); }, [] {});
+	const auto readback = graph.add_pass("readback", [&](RenderGraph::PassBuilder& b) { b.read(color); b.set_side_effect(); }, [] {});
+	const auto present = graph.add_pass("present", [&](RenderGraph::PassBuilder& b) { b.read(color); b.attach(backbuffer); }, [] {});
+	ASSERT_TRUE(graph.compile());
+	EXPECT_FALSE(graph.is_culled(scene));
+	EXPECT_TRUE(graph.is_culled(orphan));
+	EXPECT_FALSE(graph.is_culled(readback));
+	EXPECT_FALSE(graph.is_culled(present));
+	EXPECT_EQ(graph.get_execution_order().size(), 3u);
+	EXPECT_EQ(graph.get_physical_index(unused), RenderGraph::no_physical_texture);
+}
+
+TEST(RenderGraphTest, PassesRenderingOnTopOfEachOtherKeepOrder)
+{
+	RenderGraph graph;
+	const auto backbuffer = graph.import_framebuffer("backbuffer", 0);
+	const auto color = graph.create_texture("color", color_desc);
+	const auto opaque = graph.add_pass("opaque", [&](RenderGraph::PassBuilder& b) { b.attach(color); }, [] {});
+	const auto overlay = graph.add_pass("overlay", [&](RenderGraph::PassBuilder& b) { b.attach(color); }, [] {});
+	const auto present = graph.add_pass("present", [&](RenderGraph::PassBuilder& b) { b.read(color); b.attach(backbuffer); }, [] {});
+	ASSERT_TRUE(graph.compile());
+	const std::vector<RenderGraph::PassId> expected = { opaque, overlay, present };
+	EXPECT_EQ(graph.get_execution_order(), expected);
+}
+
+TEST(RenderGraphTest, AliasesTexturesWithDisjointLifetimes)
+{
+	RenderGraph graph;
+	const auto backbuffer = graph.import_framebuffer("backbuffer", 0);
+	const auto a = graph.create_texture("a", color_desc);
+	const auto b = graph.create_texture("b", color_desc);
+	const auto c = graph.create_texture("c", color_desc);
+	const auto depth = graph.create_texture("depth", depth_desc);
+	graph.add_pass("1", [&](RenderGraph::PassBuilder& pb) { pb.attach(a); pb.attach(depth); }, [] {});
+	graph.add_pass("2", [&](RenderGraph::PassBuilder& pb) { pb.read(a); pb.attach(b); }, [] {});
+	graph.add_pass("3", [&](RenderGraph::PassBuilder& pb) { pb.read(b); pb.attach(c); }, [] {});
+	graph.add_pass("4", [&](RenderGraph::PassBuilder& pb) { pb.read(c); pb.attach(backbuffer); }, [] {});
+	ASSERT_TRUE(graph.compile());
+	// a is dead after pass 2, so c can take its memory. b overlaps both
+	EXPECT_EQ(graph.get_physical_index(a), graph.get_physical_index(c));
+	EXPECT_NE(graph.get_physical_index(a), graph.get_physical_index(b));
+	// different description is never aliased
+	EXPECT_NE(graph.get_physical_index(depth), graph.get_physical_index(a));
+	EXPECT_NE(graph.get_physical_index(depth), graph.get_physical_index(b));
+	EXPECT_EQ(graph.get_physical_count(), 3u);
+}
+
+TEST(RenderGraphTest, CycleFailsToCompile)
+{
+	RenderGraph graph;
+	const auto backbuffer = graph.import_framebuffer("backbuffer", 0);
+	const auto a = graph.create_texture("a", color_desc);
+	const auto b = graph.create_texture("b", color_desc);
+	graph.add_pass("1", [&](RenderGraph::PassBuilder& pb) { pb.read(b); pb.attach(a); }, [] {});
+	graph.add_pass("2", [&](RenderGraph::PassBuilder& pb) { pb.read(a); pb.attach(b); }, [] {});
+	graph.add_pass("3", [&](RenderGraph::PassBuilder& pb) { pb.read(b); pb.attach(backbuffer); }, [] {});
+	EXPECT_FALSE(graph.compile());
+}
@@ -0,0 +1,69 @@
+#include "core/RenderQueue.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+using namespace fury;
+
+TEST(RenderQueueTest, KeyFieldsOrder)
+{
+  // more significant field wins regardless of less significant ones
+  EXPECT_LT(RenderQueue::make_key(0, 5, 5, 5, 5), RenderQueue::make_key(1, 0, 0, 0, 0));
+  EXPECT_LT(RenderQueue::make_key(0, 0, 5, 5, 5), RenderQueue::make_key(0, 1, 0, 0, 0));
+  EXPECT_LT(RenderQueue::make_key(0, 0, 0, 5, 5), RenderQueue::make_key(0, 0, 1, 0, 0));
+  EXPECT_LT(RenderQueue::make_key(0, 0, 0, 0, 5), RenderQueue::make_key(0, 0, 0, 1, 0));
+  EXPECT_EQ(RenderQueue::make_key(0, 0, 0, 0, 0), 0u);
+  EXPECT_EQ(RenderQueue::make_key(0xF, 0xFF, 0xFFF, 0xFFFF, 0xFFFFFF), ~uint64_t(0));
+}
+
+TEST(RenderQueueTest, QuantizeDepth)
+{
+  EXPECT_EQ(RenderQueue::quantize_depth(0.1f, 0.1f, 100.f), 0u);
+  EXPECT_EQ(RenderQueue::quantize_depth(100.f, 0.1f, 100.f), (1u << RenderQueue::depth_bits) - 1);
+  EXPECT_EQ(RenderQueue::quantize_depth(-5.f, 0.1f, 100.f), 0u);
+  EXPECT_EQ(RenderQueue::quantize_depth(500.f, 0.1f, 100.f), (1u << RenderQueue::depth_bits) - 1);
+  EXPECT_LT(RenderQueue::quantize_depth(10.f, 0.1f, 100.f), RenderQueue::quantize_depth(11.f, 0.1f, 100.f));
+}
+
+TEST(RenderQueueTest, SortMatchesStableSort)
+{
+  std::mt19937_64 rng(42);
+  RenderQueue queue;
+  std::vector<RenderQueue::Item> expected;
+  for (uint32_t i = 0; i < 1000; i++)
+  {
+    // few distinct states so that there are many equal keys
+    const uint64_t key = RenderQueue::make_key(rng() % 2, rng() % 3, rng() % 4, rng() % 5, static_cast<uint32_t>(rng() % 7));
+    queue.push(key, i);
+    expected.push_back({ key, i });
+  }
+  std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+  queue.sort();
+  ASSERT_EQ(queue.items().size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++)
+  {
+    EXPECT_EQ(queue.items()[i].key, expected[i].key);
+    EXPECT_EQ(queue.items()[i].payload, expected[i].payload);
+  }
+}
+
+TEST(RenderQueueTest, StateChangesStats)
+{
+  RenderQueue queue;
+  // A B A B, where depth differs only inside same state
+  queue.push(RenderQueue::make_key(0, 0, 0, 1, 10), 0);
+  queue.push(RenderQueue::make_key(0, 0, 0, 2, 10), 1);
+  queue.push(RenderQueue::make_key(0, 0, 0, 1, 5), 2);
+  queue.push(RenderQueue::make_key(0, 0, 0, 2, 5), 3);
+  queue.sort();
+  const RenderQueue::Stats& stats = queue.get_stats();
+  EXPECT_EQ(stats.items, 4u);
+  EXPECT_EQ(stats.state_changes_unsorted, 3u);
+  EXPECT_EQ(stats.state_changes, 1u);
+  // front to back within same material
+  EXPECT_EQ(queue.items()[0].payload, 2u);
+  EXPECT_EQ(queue.items()[1].payload, 0u);
+  queue.clear();
+  EXPECT_TRUE(queue.items().empty());
+  EXPECT_EQ(queue.get_stats().items, 0u);
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "core/ShadowCascades.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace fury;
+
+namespace
+{
+	// scale of light space x axis, doesn't depend on where the slice is
+	float get_x_scale(const glm::mat4& m)
+	{
+		return glm::length(glm::vec3(m[0][0], m[1][0], m[2][0]));
+	}
+}
+
+TEST(ShadowCascadesTest, Splits)
+{
+	const auto splits = shadow_cascades::compute_splits(0.1f, 100.f);
+	EXPECT_NEAR(splits.back(), 100.f, 1e-3f);
+	for (int i = 1; i < shadow_cascades::count; i++)
+	{
+		EXPECT_GT(splits[i], splits[i - 1]);
+	}
+	// logarithmic scheme gives more resolution near camera
+	const auto uniform = shadow_cascades::compute_splits(0.1f, 100.f, 0.f);
+	EXPECT_LT(splits[0], uniform[0]);
+}
+
+TEST(ShadowCascadesTest, FitCoversSlice)
+{
+	const glm::mat4 view = glm::lookAt(glm::vec3(0, 2, 5), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+	const auto corners = shadow_cascades::get_slice_corners(view, 45.f, 16.f / 9.f, 0.1f, 10.f);
+	const BoundingBox scene_bbox(glm::vec3(-20.f), glm::vec3(20.f));
+	const glm::mat4 m = shadow_cascades::fit(corners, glm::vec3(0.3f, -1.f, 0.2f), scene_bbox, 2048);
+	for (const glm::vec3& corner : corners)
+	{
+		const glm::vec4 clip = m * glm::vec4(corner, 1.f);
+		EXPECT_LE(std::abs(clip.x), 1.f);
+		EXPECT_LE(std::abs(clip.y), 1.f);
+		EXPECT_LE(std::abs(clip.z), 1.f);
+	}
+	// casters outside of the slice but inside scene are not clipped by depth range
+	for (const glm::vec3& point : scene_bbox.get_points())
+	{
+		EXPECT_LE(std::abs((m * glm::vec4(point, 1.f)).z), 1.f);
+	}
+}
+
+TEST(ShadowCascadesTest, StableUnderCameraRotation)
+{
+	const glm::vec3 light_dir(0.3f, -1.f, 0.2f);
+	const BoundingBox scene_bbox(glm::vec3(-20.f), glm::vec3(20.f));
+	const glm::vec3 eye(0, 2, 5);
+	const glm::mat4 view1 = glm::lookAt(eye, glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+	const glm::mat4 view2 = glm::lookAt(eye, glm::vec3(3, 1, 0), glm::vec3(0, 1, 0));
+	const glm::mat4 m1 = shadow_cascades::fit(shadow_cascades::get_slice_corners(view1, 45.f, 1.5f, 1.f, 10.f), light_dir, scene_bbox, 2048);
+	const glm::mat4 m2 = shadow_cascades::fit(shadow_cascades::get_slice_corners(view2, 45.f, 1.5f, 1.f, 10.f), light_dir, scene_bbox, 2048);
+	// shadow map texel size doesn't change when camera turns around
+	EXPECT_FLOAT_EQ(get_x_scale(m1), get_x_scale(m2));
+	// and the same view gives exactly the same matrix
+	const glm::mat4 m3 = shadow_cascades::fit(shadow_cascades::get_slice_corners(view1, 45.f, 1.5f, 1.f, 10.f), light_dir, scene_bbox, 2048);
+	EXPECT_TRUE(m1 == m3);
+}
+
+TEST(ShadowCascadesTest, StableUnderSmallCameraAndSceneChanges)
+{
+	const glm::vec3 light_dir(0.3f, -1.f, 0.2f);
+	const BoundingBox scene_bbox(glm::vec3(-20.f), glm::vec3(20.f));
+	const auto fit_at = [&](const glm::vec3& eye, const BoundingBox& bbox)
+	{
+		const glm::mat4 view = glm::lookAt(eye, eye + glm::vec3(0, -0.4f, -1), glm::vec3(0, 1, 0));
+		return shadow_cascades::fit(shadow_cascades::get_slice_corners(view, 45.f, 1.5f, 1.f, 10.f), light_dir, bbox, 2048);
+	};
+	// camera walks one unit in texel sized steps, matrix changes only when snapped center crosses guard sized grid
+	int changes = 0;
+	glm::mat4 prev = fit_at(glm::vec3(0, 2, 5), scene_bbox);
+	for (int i = 1; i <= 100; i++)
+	{
+		const glm::mat4 m = fit_at(glm::vec3(0.01f * i, 2, 5), scene_bbox);
+		changes += m != prev;
+		prev = m;
+	}
+	EXPECT_LE(changes, 4);
+	// object moves grow scene bbox a bit, depth range stays in the same bucket most of the time
+	changes = 0;
+	prev = fit_at(glm::vec3(0, 2, 5), scene_bbox);
+	for (int i = 1; i <= 100; i++)
+	{
+		const glm::mat4 m = fit_at(glm::vec3(0, 2, 5), BoundingBox(glm::vec3(-20.f), glm::vec3(20.f + 0.01f * i)));
+		changes += m != prev;
+		prev = m;
+	}
+	EXPECT_LE(changes, 2);
+}
@@ -0,0 +1,67 @@
+#include "core/SlotMap.hpp"
+#include <gtest/gtest.h>
+
+using namespace fury;
+
+TEST(SlotMapTest, InsertAssignsDenseIndices)
+{
+  SlotMap<uint32_t, int> map;
+  EXPECT_EQ(map.insert_or_assign(10, 1), 0u);
+  EXPECT_EQ(map.insert_or_assign(20, 2), 1u);
+  // existing key is updated in place
+  EXPECT_EQ(map.insert_or_assign(10, 3), 0u);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.values()[0], 3);
+  EXPECT_EQ(map.key_at(1), 20u);
+}
+
+TEST(SlotMapTest, EraseMovesLastIntoHole)
+{
+  SlotMap<uint32_t, int> map;
+  map.insert_or_assign(1, 10);
+  map.insert_or_assign(2, 20);
+  map.insert_or_assign(3, 30);
+  EXPECT_EQ(map.erase(1), 0u);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.values()[0], 30);
+  EXPECT_EQ(map.index_of(3), 0u);
+  EXPECT_EQ(map.index_of(2), 1u);
+  EXPECT_FALSE(map.contains(1));
+}
+
+TEST(SlotMapTest, EraseLastOrMissing)
+{
+  SlotMap<uint32_t, int> map;
+  map.insert_or_assign(1, 10);
+  map.insert_or_assign(2, 20);
+  // nothing moved
+  EXPECT_FALSE(map.erase(2).has_value());
+  EXPECT_FALSE(map.erase(5).has_value());
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_FALSE(map.erase(1).has_value());
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(SlotMapTest, KeysStayConsistentUnderChurn)
+{
+  SlotMap<uint32_t, uint32_t> map;
+  for (uint32_t key = 0; key < 1000; key++)
+  {
+    map.insert_or_assign(key, key * 2);
+  }
+  for (uint32_t key = 0; key < 1000; key += 3)
+  {
+    map.erase(key);
+  }
+  for (uint32_t key = 0; key < 1000; key++)
+  {
+    if (key % 3 == 0)
+    {
+      EXPECT_FALSE(map.contains(key));
+      continue;
+    }
+    const size_t idx = *map.index_of(key);
+    EXPECT_EQ(map.key_at(idx), key);
+    EXPECT_EQ(map.values()[idx], key * 2);
+  }
+}
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "core/StressScene.hpp"
+#include <cmath>
+
+using namespace fury;
+using stress_scene::ObjectKind;
+
+namespace
+{
+	size_t count_kind(const stress_scene::Plan& plan, ObjectKind kind)
+	{
+		size_t count = 0;
+		for (const stress_scene::ObjectSpec& spec : plan.objects)
+		{
+			count += spec.kind == kind;
+		}
+		return count;
+	}
+}
+
+TEST(StressSceneTest, SameSeedGivesSamePlan)
+{
+	stress_scene::Config config;
+	config.object_count = 1000;
+	config.hierarchy_depth = 4;
+	config.animated_fraction = 0.3f;
+	config.light_count = 8;
+	const stress_scene::Plan a = stress_scene::make_plan(config);
+	const stress_scene::Plan b = stress_scene::make_plan(config);
+	ASSERT_EQ(a.objects.size(), 1000u);
+	ASSERT_EQ(a.lights.size(), 8u);
+	for (size_t i = 0; i < a.objects.size(); i++)
+	{
+		EXPECT_EQ(a.objects[i].kind, b.objects[i].kind);
+		EXPECT_EQ(a.objects[i].translation, b.objects[i].translation);
+		EXPECT_EQ(a.objects[i].color, b.objects[i].color);
+		EXPECT_EQ(a.objects[i].animated, b.objects[i].animated);
+	}
+	config.seed = 2;
+	const stress_scene::Plan c = stress_scene::make_plan(config);
+	EXPECT_NE(a.objects[0].translation, c.objects[0].translation);
+}
+
+TEST(StressSceneTest, ObjectsFormChainsOfHierarchyDepth)
+{
+	stress_scene::Config config;
+	config.object_count = 100;
+	config.hierarchy_depth = 5;
+	const stress_scene::Plan plan = stress_scene::make_plan(config);
+	for (size_t i = 0; i < plan.objects.size(); i++)
+	{
+		const stress_scene::ObjectSpec& spec = plan.objects[i];
+		if (i % 5 == 0)
+		{
+			EXPECT_EQ(spec.parent, -1);
+			EXPECT_LE(std::abs(spec.translation.x), plan.half_extent);
+			EXPECT_LE(std::abs(spec.translation.y), plan.half_extent);
+			EXPECT_LE(std::abs(spec.translation.z), plan.half_extent);
+		}
+		else
+		{
+			EXPECT_EQ(spec.parent, static_cast<int32_t>(i - 1));
+		}
+	}
+}
+
+TEST(StressSceneTest, KindsAndAnimationFollowConfig)
+{
+	stress_scene::Config config;
+	config.object_count = 10000;
+	config.animated_fraction = 0.25f;
+	config.texture_count = 4;
+	const stress_scene::Plan plan = stress_scene::make_plan(config);
+	// no model files, so no model instances
+	EXPECT_EQ(count_kind(plan, ObjectKind::MODEL), 0u);
+	EXPECT_GT(count_kind(plan, ObjectKind::CURVE), 0u);
+	EXPECT_GT(count_kind(plan, ObjectKind::CUBE), count_kind(plan, ObjectKind::ICOSAHEDRON));
+	size_t animated = 0;
+	for (const stress_scene::ObjectSpec& spec : plan.objects)
+	{
+		animated += spec.animated;
+		if (spec.kind == ObjectKind::CUBE)
+		{
+			EXPECT_GE(spec.variant, 0);
+			EXPECT_LT(spec.variant, 4);
+		}
+	}
+	EXPECT_NEAR(animated / 10000.f, 0.25f, 0.03f);
+}
+
+TEST(StressSceneTest, ModelInstancesReferenceModelFiles)
+{
+	stress_scene::Config config;
+	config.object_count = 1000;
+	config.model_files = { "a.obj", "b.obj" };
+	config.kind_weights = { 0.f, 0.f, 0.f, 1.f };
+	const stress_scene::Plan plan = stress_scene::make_plan(config);
+	EXPECT_EQ(count_kind(plan, ObjectKind::MODEL), 1000u);
+	for (const stress_scene::ObjectSpec& spec : plan.objects)
+	{
+		EXPECT_TRUE(spec.variant == 0 || spec.variant == 1);
+	}
+}
+
+TEST(StressSceneTest, TexturesDifferByIndex)
+{
+	const std::vector<uint8_t> a = stress_scene::make_texture_pixels(0, 16);
+	const std::vector<uint8_t> b = stress_scene::make_texture_pixels(1, 16);
+	ASSERT_EQ(a.size(), 16u * 16u * 4u);
+	EXPECT_NE(a, b);
+	EXPECT_EQ(a[3], 255);
+}
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "ge/Vertex.hpp"
+
+using namespace fury;
+
+TEST(VertexPackingTest, OctahedralRoundTrip)
+{
+	const glm::vec3 normals[] = {
+		{ 1.f, 0.f, 0.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f },
+		glm::normalize(glm::vec3(1.f, 2.f, -3.f)), glm::normalize(glm::vec3(-0.3f, -0.5f, -0.8f))
+	};
+	for (const glm::vec3& n : normals)
+	{
+		const glm::vec2 e = vertex_packing::oct_encode(n);
+		EXPECT_LE(std::abs(e.x), 1.f);
+		EXPECT_LE(std::abs(e.y), 1.f);
+		const glm::vec3 decoded = vertex_packing::oct_decode(e);
+		EXPECT_NEAR(glm::dot(n, decoded), 1.f, 1e-5f);
+	}
+}
+
+TEST(VertexPackingTest, PositionQuantizedWithinBounds)
+{
+	const glm::vec3 min(-2.f, 0.f, 10.f);
+	const glm::vec3 size(4.f, 1.f, 0.f);
+	const PackedVertex low = vertex_packing::pack(Vertex(min), min, size);
+	const PackedVertex high = vertex_packing::pack(Vertex(min + size), min, size);
+	const PackedVertex mid = vertex_packing::pack(Vertex(-1.f, 0.25f, 10.f), min, size);
+	EXPECT_EQ(low.position[0], 0);
+	EXPECT_EQ(high.position[0], 65535);
+	EXPECT_EQ(high.position[1], 65535);
+	// flat axis
+	EXPECT_EQ(high.position[2], 0);
+	EXPECT_NEAR(mid.position[0] / 65535.f * size.x + min.x, -1.f, 1e-4f);
+	EXPECT_NEAR(mid.position[1] / 65535.f * size.y + min.y, 0.25f, 1e-4f);
+}